@@ -0,0 +1,54 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+// One bit per pixel, each row packed into 32-bit words (bit x % 32 of word
+// x / 32), so rule-based effects update 32 cells per operation. Bits past
+// the width are kept 0.
+class Bitboard {
+public:
+  static const int WORD_BITS = 32;
+
+  Bitboard();
+  ~Bitboard();
+
+  // Size the board and clear it; the only call that allocates
+  bool allocate(int width, int height);
+
+  int getWidth() const { return width_; }
+  int getHeight() const { return height_; }
+  int getWordsPerRow() const { return words_per_row_; }
+
+  uint32_t* row(int y) { return bits_ + y * words_per_row_; }
+  const uint32_t* row(int y) const { return bits_ + y * words_per_row_; }
+
+  bool get(int x, int y) const { return (row(y)[x / WORD_BITS] >> (x % WORD_BITS)) & 1; }
+  void set(int x, int y, bool on);
+
+  void clear();
+  void copyFrom(const Bitboard& other);   // Same size
+  bool equals(const Bitboard& other) const;
+  int count() const;                       // Cells that are set
+
+  // Zero the bits past the width in a row buffer
+  void maskRow(uint32_t* bits) const;
+
+  // out[x] = bits[x - 1] (west neighbour) or bits[x + 1] (east neighbour),
+  // wrapping around the width
+  void shiftFromWest(const uint32_t* bits, uint32_t* out) const;
+  void shiftFromEast(const uint32_t* bits, uint32_t* out) const;
+
+private:
+  int width_;
+  int height_;
+  int words_per_row_;
+  uint32_t tail_mask_;   // Valid bits of the last word in a row
+  uint32_t* bits_;
+
+  // Non-copyable (owns the bits)
+  Bitboard(const Bitboard&);
+  Bitboard& operator=(const Bitboard&);
+};
+
+#endif // BITBOARD_H
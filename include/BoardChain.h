@@ -0,0 +1,89 @@
+#ifndef BOARD_CHAIN_H
+#define BOARD_CHAIN_H
+
+#include <stdint.h>
+#include "I2CBus.h"
+#include "Tca9548aMux.h"
+#include "PanelLayout.h"
+#include "BurstPlanner.h"
+
+// Register-level control of a set of IS31FL3737 boards spread over up to two
+// I2C buses, each optionally fanned out through a TCA9548A mux. Keeps the
+// last transmitted PWM image per board so a flush only sends changed runs.
+// Hardware-independent: the buses are I2CBus implementations.
+class BoardChain {
+public:
+  static const int MAX_BUSES = 2;
+  static const uint8_t NO_MUX_CHANNEL = Tca9548aMux::NO_CHANNEL;  // Board sits on the trunk
+
+  // I2C traffic accounting, one set per bus
+  struct FlushStats {
+    uint32_t bytes_last_frame;      // Bytes on the wire for the most recent flush
+    uint16_t bursts_last_frame;     // Write transactions for the most recent flush
+    uint16_t boards_last_frame;     // Boards that actually had changes
+    uint16_t selects_last_frame;    // Mux channel switches for the most recent flush
+    uint32_t bytes_total;           // Since the last resetStats()
+    uint32_t frames_total;
+  };
+
+  BoardChain();
+  ~BoardChain();
+
+  // Topology
+  void attachBus(int bus, I2CBus* i2c, Tca9548aMux* mux = nullptr);
+  void resize(int num_boards);
+  void setBoard(int board, uint8_t bus, uint8_t mux_channel, uint8_t address);
+  int getBoardCount() const { return num_boards_; }
+  uint8_t getBus(int board) const { return boards_[board].bus; }
+  uint8_t getMuxChannel(int board) const { return boards_[board].mux_channel; }
+  uint8_t getAddress(int board) const { return boards_[board].address; }
+  bool isOnline(int board) const { return boards_[board].online; }
+  bool isBusUsed(int bus) const;
+  I2CBus* getBus(int bus, Tca9548aMux** mux) const;
+
+  // Board control (routes through the mux as needed)
+  bool probe(int board);
+  bool initializeBoard(int board, uint8_t global_current);  // Marks the board online
+  bool setGlobalCurrent(int board, uint8_t current);
+  bool writePwmRegister(int board, uint8_t pwm_register, uint8_t value);  // Bypasses the image
+  void invalidate(int board);  // Chip state unknown - next flush rewrites the page
+
+  // Render dirty boards on `bus` from a framebuffer through the layout table
+  // and send only the changed register runs. Boards are visited grouped by
+  // mux channel, starting with the channel already selected, so each channel
+  // with changes costs at most one select per frame. Clears their dirty flags.
+  void flushBus(int bus, const uint8_t* frame, const PhysicalPixel* map, int pixel_count,
+                bool* dirty, uint8_t master_brightness);
+
+  const FlushStats& getStats(int bus) const { return stats_[bus]; }
+  void resetStats();
+
+private:
+  struct Board {
+    uint8_t bus;
+    uint8_t mux_channel;
+    uint8_t address;
+    uint8_t current_page;   // PAGE_UNKNOWN if unsure
+    bool online;            // Initialized successfully
+    bool sent_valid;        // sent_pwm_ matches the chip
+  };
+
+  Board* boards_;
+  int num_boards_;
+  uint8_t* sent_pwm_;       // What each chip holds
+  uint8_t* next_pwm_;       // What the framebuffer wants
+  I2CBus* buses_[MAX_BUSES];
+  Tca9548aMux* muxes_[MAX_BUSES];
+  FlushStats stats_[MAX_BUSES];
+
+  bool route(int board, FlushStats* stats);
+  bool selectPage(int board, uint8_t page, FlushStats* stats);
+  bool writeRegisters(int board, uint8_t start_register, const uint8_t* data, int length);
+  void flushBoard(int board);
+
+  // Non-copyable (owns the images)
+  BoardChain(const BoardChain&);
+  BoardChain& operator=(const BoardChain&);
+};
+
+#endif // BOARD_CHAIN_H
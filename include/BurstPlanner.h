@@ -0,0 +1,31 @@
+#ifndef BURST_PLANNER_H
+#define BURST_PLANNER_H
+
+#include <stdint.h>
+
+// One auto-increment register write: `length` bytes starting at `start`
+struct RegisterBurst {
+  uint8_t start;
+  uint8_t length;
+};
+
+// Plans the fewest/cheapest I2C burst writes that bring a device's register
+// page from the last transmitted image to the next one.
+class BurstPlanner {
+public:
+  // Bytes every write transaction costs besides its payload (address + register)
+  static const int TRANSACTION_OVERHEAD = 2;
+
+  // Diff `next` against `sent` (count registers) and coalesce changed registers
+  // into bursts. Runs of up to `merge_gap` unchanged registers are re-sent when
+  // that is cheaper than opening a new transaction. A null `sent` means the
+  // device state is unknown and everything is written. `out` must hold at
+  // least count / 2 + 1 entries. Returns the number of bursts.
+  static int plan(const uint8_t* sent, const uint8_t* next, int count,
+                  int merge_gap, int max_burst_length, RegisterBurst* out);
+
+  // Bytes on the wire for a set of bursts, including per-transaction overhead
+  static int wireBytes(const RegisterBurst* bursts, int count);
+};
+
+#endif // BURST_PLANNER_H
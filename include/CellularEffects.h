@@ -0,0 +1,136 @@
+#ifndef CELLULAR_EFFECTS_H
+#define CELLULAR_EFFECTS_H
+
+#include <stdint.h>
+#include "Effect.h"
+#include "Bitboard.h"
+#include "Xorshift32.h"
+
+// Screensaver effects built on bitboards: every step works on whole
+// 32-column words with shifts and logic ops, and render() expands three
+// bit planes into brightness through an 8-entry table. Cheap enough to
+// leave most of the CPU to the network task.
+class BitboardEffect : public Effect {
+public:
+  ~BitboardEffect();
+
+  bool init(int width, int height) override;
+  void update(uint32_t elapsed_ms) override;
+  void render(uint8_t* frame) override;
+  uint8_t getTargetFps() const override { return steps_per_second_; }
+  void reset() override;
+
+protected:
+  BitboardEffect(uint8_t steps_per_second, uint32_t seed);
+
+  virtual void seed() = 0;   // Fill plane(0) with a starting state
+  virtual void step() = 0;   // Compute the next state
+  virtual bool allocateExtra() { return true; }   // For subclass buffers, from init()
+
+  // Plane 0/1/2 supply bit 0/1/2 of the index into levels_. Effects with
+  // history keep the state in plane 0 and the last two states behind it.
+  Bitboard& plane(int index) { return *planes_[index]; }
+  void rotateHistory();      // Plane 0 becomes free to hold the next state
+
+  uint32_t random() { return rng_.next(); }
+  uint32_t randomBits(int sparsity);   // Each bit set with probability 2^-sparsity
+
+  int width_;
+  int height_;
+  uint8_t levels_[8];
+  uint32_t* scratch_;        // Two rows of words for subclasses
+
+private:
+  Bitboard storage_[3];
+  Bitboard* planes_[3];
+  uint8_t steps_per_second_;
+  Xorshift32 rng_;
+  uint32_t pending_ms_;
+
+  // Non-copyable (owns the planes)
+  BitboardEffect(const BitboardEffect&);
+  BitboardEffect& operator=(const BitboardEffect&);
+};
+
+// Conway's Game of Life on a torus; newborn cells flash and dying ones
+// fade. Reseeds when the board dies out or settles into a still life or
+// blinker.
+class LifeEffect : public BitboardEffect {
+public:
+  LifeEffect();
+  const char* getName() const override { return "Game of Life"; }
+
+protected:
+  bool allocateExtra() override;
+  void seed() override;
+  void step() override;
+
+private:
+  Bitboard west_;
+  Bitboard east_;
+  int stagnant_steps_;
+};
+
+// Elementary (1-D) automaton such as rule 30 or 110. Each step computes a
+// new bottom row from the one above it and scrolls the history up.
+class ElementaryEffect : public BitboardEffect {
+public:
+  explicit ElementaryEffect(uint8_t rule);
+  const char* getName() const override { return name_; }
+
+protected:
+  void seed() override;
+  void step() override;
+
+private:
+  uint8_t rule_;
+  char name_[12];
+  int stagnant_steps_;
+};
+
+// Drops appear on the top row and fall one row per step, with trails
+class RainEffect : public BitboardEffect {
+public:
+  RainEffect();
+  const char* getName() const override { return "Rain"; }
+
+protected:
+  void seed() override;
+  void step() override;
+};
+
+// Random pixels flash up and fade over the next two steps
+class SparkleEffect : public BitboardEffect {
+public:
+  SparkleEffect();
+  const char* getName() const override { return "Sparkle"; }
+
+protected:
+  void seed() override;
+  void step() override;
+};
+
+// Cloudy 3-bit noise scrolling left. The three planes hold the bits of
+// each pixel's level; a new right-hand column comes from a random walk
+// per row, smoothed between rows.
+class NoiseEffect : public BitboardEffect {
+public:
+  NoiseEffect();
+  ~NoiseEffect();
+  const char* getName() const override { return "Noise"; }
+
+protected:
+  bool allocateExtra() override;
+  void seed() override;
+  void step() override;
+
+private:
+  uint8_t* column_;   // Level of each row's newest column, 0-7
+  uint8_t* smoothed_;
+
+  // Non-copyable (owns the columns)
+  NoiseEffect(const NoiseEffect&);
+  NoiseEffect& operator=(const NoiseEffect&);
+};
+
+#endif // CELLULAR_EFFECTS_H
@@ -43,8 +43,7 @@ private:
   // Configuration
   unsigned long update_interval_;
   unsigned long last_update_time_;
-  uint8_t time_brightness_;
-  uint8_t date_brightness_;
+  RetroText::TrailingSpanRule time_style_;  // Time bright, date dim
   
   // Time data
   tm timeinfo_;
@@ -58,10 +57,6 @@ private:
   // Internal methods
   String formatClockDisplay();
   void setupController();
-  static uint8_t clockBrightnessCallback(char c, String text, int char_pos, bool is_time_display);
-  
-  // Static reference for callback
-  static ClockDisplay* instance_;
 };
 
 #endif // CLOCK_DISPLAY_H
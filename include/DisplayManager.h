@@ -2,16 +2,63 @@
 #define DISPLAY_MANAGER_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <Wire.h>
 #include "IS31FL373x.h"
+#include "PanelLayout.h"
+#include "BoardChain.h"
+#include "WireBus.h"
+#include "Tca9548aMux.h"
+#include "PixelKernels.h"
+#include "ShaderEffect.h"
 
 class DisplayManager {
 public:
-  // Constructor - initializes the display with board configuration
-  DisplayManager(int num_boards = 3, int board_width = 24, int board_height = 6);
+  // I2C traffic accounting for updateDisplay() - written by the flush tasks
+  // when async flushing is on, so reads may lag a frame behind
+  typedef BoardChain::FlushStats FlushStats;
+  
+  // Which I2C controller, mux channel and ADDR jumper setting a board uses
+  struct BoardConfig {
+    uint8_t bus;          // 0 = Wire, 1 = Wire1
+    uint8_t mux_channel;  // NO_MUX_CHANNEL if the board is not behind a mux
+    ADDR addr;
+  };
+  
+  // Layers, composited bottom up when a frame is presented. Pixels at 0 are
+  // transparent in every blend mode.
+  enum Layer {
+    LAYER_BACKGROUND = 0,
+    LAYER_CONTENT = 1,
+    LAYER_OVERLAY = 2,
+    LAYER_COUNT = 3
+  };
+  enum BlendMode {
+    BLEND_REPLACE = 0,   // Lit pixels replace what is below
+    BLEND_ADD = 1,       // Saturating add
+    BLEND_MAX = 2,       // The brighter of the two
+    BLEND_ALPHA = 3      // Lit pixels mix with what is below by alpha / 256
+  };
+  
+  static const int MAX_BUSES = BoardChain::MAX_BUSES;
+  static const uint8_t NO_MUX_CHANNEL = BoardChain::NO_MUX_CHANNEL;
+  
+  // Constructor - initializes the display with board configuration.
+  // Boards are tiled in board_rows rows of num_boards / board_rows boards;
+  // a board count that does not fill the rows evenly falls back to one row.
+  DisplayManager(int num_boards = 3, int board_width = 24, int board_height = 6, int board_rows = 1);
   
   // Destructor
   ~DisplayManager();
   
+  // Bus assignment - call before initialize(). Without a mux, boards 0-3 use
+  // Wire and 4-7 use Wire1 with ADDR GND/VCC/SDA/SCL. Bus 1 needs pins.
+  void configureBus(int bus, int sda_pin, int scl_pin, uint32_t frequency = 800000);
+  // Put a TCA9548A on a bus; its boards get 4 per channel in board order
+  void configureMux(int bus, uint8_t mux_address = Tca9548aMux::DEFAULT_ADDRESS);
+  bool setBoardConfig(int board_index, uint8_t bus, ADDR addr, uint8_t mux_channel = NO_MUX_CHANNEL);
+  int getBoardCount() const { return num_boards_; }
+  
   // Initialization
   bool initialize();
   bool verifyDrivers();
@@ -32,13 +79,65 @@ public:
   // Buffer operations
   void clearBuffer();
   void fillBuffer(uint8_t brightness);
-  void dimBuffer(uint8_t amount);
-  void updateDisplay();  // Push buffer to hardware
+  void dimBuffer(uint8_t amount);  // Decay every pixel by amount / 256 of its level
+  // Combine a full frame (getWidth() x getHeight(), row-major) into the draw
+  // layer; 0 pixels are transparent. For effects and crossfades.
+  void blendFrame(const uint8_t* pixels, BlendMode mode = BLEND_REPLACE, uint8_t alpha = 255);
+  // Set every pixel of the draw layer to shader(x, y, t) - a PixelShader or
+  // a lambda, see ShaderEffect
+  template <typename Shader>
+  void shade(Shader shader, uint32_t t) {
+    ShaderEffect::evaluate(shader, drawBuffer(), total_width_, total_height_, t);
+    markAllDrawn();
+  }
+  void setMasterBrightness(uint8_t brightness);  // Scales all output at flush time, 255 = full
+  void updateDisplay();  // Push changed registers to hardware (same as present())
+  
+  // Bumped by every change to the back buffer. Retained-mode renderers keep
+  // the value after drawing; if it moved, someone else drew over them.
+  uint32_t getBufferVersion() const { return buffer_version_; }
+  
+  // Double buffering: drawing always targets the back buffer. present() hands
+  // it to one flush task per bus on the other core and returns while they
+  // transmit in parallel; without startAsyncFlush() it flushes synchronously.
+  bool startAsyncFlush(int core = 0);
+  void present();
+  void waitForFlush();  // Block until the last presented frame is on the wire
+  bool isAsyncFlush() const { return async_flush_; }
+  
+  // Flush statistics summed over all buses (bytes per frame = bytes_total / frames_total)
+  FlushStats getFlushStats() const;
+  void resetFlushStats();
+  
+  // Layers are off by default and drawing goes straight to the frame.
+  // Enabling the background or overlay gives each layer its own buffer (the
+  // current frame becomes the content layer) and present() composites them
+  // in one pass; disabling both goes back to drawing on the frame. Content
+  // is always on, enableLayer() only sets its blend mode.
+  void enableLayer(Layer layer, BlendMode mode = BLEND_REPLACE, uint8_t alpha = 255);
+  void disableLayer(Layer layer);
+  bool isLayerEnabled(Layer layer) const { return layer_enabled_[layer]; }
+  void setDrawLayer(Layer layer);  // Where every drawing call goes, including clearBuffer() and getPixel()
+  Layer getDrawLayer() const { return draw_layer_; }
   
   // Higher-level drawing operations
   void drawCharacter(uint8_t character_pattern[6], int x_offset, uint8_t brightness);
+  void drawGlyph(uint8_t character, int x_offset, uint8_t brightness, bool use_alt_font = true);
   void drawText(const String& text, int start_x, uint8_t brightness, bool use_alt_font = true);
   
+  // Write a 1-bit glyph (one byte per row, MSB of `width` bits leftmost)
+  // straight into the framebuffer, clipped once to the screen edges. Set
+  // bits get `on`, clear bits `off`. Width is at most 8.
+  void blitGlyph(const uint8_t* rows, int height, int width, int x, int y, uint8_t on, uint8_t off = 0);
+  
+  // Write `width` pixel columns starting at x: column i lights row r of the
+  // band at y when bit r of masks[i] is set, at levels[i]. Columns from
+  // `count` on are cleared. Used to copy windows of pre-rasterized text.
+  // A non-zero `fraction` shifts the window left by fraction/256 of a
+  // column, blending each column with its right neighbour (sub-pixel scroll).
+  void blitColumns(const uint8_t* masks, const uint8_t* levels, int count, int width,
+                   int x, int y, int height, uint8_t fraction = 0);
+  
   // Configuration
   void setGlobalBrightness(uint8_t brightness);
   void setBoardBrightness(int board_index, uint8_t brightness);
@@ -46,12 +145,19 @@ public:
   // Hardware-specific methods
   int getBoardForPixel(int x) const;
   
+  // Board layout - replaces the default right-to-left, upside-down chain.
+  // Returns false and keeps the current layout if a placement names a board
+  // past the chain.
+  bool setLayout(const BoardPlacement* placements, int count);
+  
   // Font access (temporary - should be moved to font manager later)
   uint8_t getCharacterPattern(uint8_t character, uint8_t row, bool use_alt_font = true) const;
+  void getGlyph(uint8_t character, uint8_t rows[6], bool use_alt_font = true) const;  // All 6 rows at once
   
 private:
   // Hardware configuration
   int num_boards_;
+  int board_rows_;
   int board_width_;
   int board_height_;
   int total_width_;
@@ -59,13 +165,80 @@ private:
   int character_width_;
   int max_characters_;
   
-  // Hardware abstraction - IS31FL373x driver integration
-  static const int PIXELS_PER_BOARD = 12 * 12;  // IS31FL3737 native configuration
-  IS31FL3737* drivers_[4];  // Individual drivers for each board
+  // Hardware abstraction - IS31FL3737 boards addressed at register level
+  BoardConfig* boards_;              // Board index -> bus, mux channel, ADDR
+  BoardChain chain_;                 // Register images, pages and flushing
+  WireBus wire_buses_[MAX_BUSES];
+  Tca9548aMux* muxes_[MAX_BUSES];
+  int bus_sda_[MAX_BUSES];
+  int bus_scl_[MAX_BUSES];
+  uint32_t bus_frequency_[MAX_BUSES];
+  PanelLayout layout_;               // Logical pixel -> (board, CS, SW) table
+  
+  // Logical framebuffers (total_width_ x total_height_, row-major). Drawing
+  // goes to frame_buffer_ (back); front_buffer_ is the frame being flushed.
+  uint8_t* frame_buffer_;
+  uint8_t* front_buffer_;
+  bool* board_dirty_;  // Board content changed since last present
+  bool* front_dirty_;  // Boards the front frame needs to send
+  uint8_t* blend_scratch_;  // Sub-pixel blend weights and row, 3 x total_width_
+  uint32_t buffer_version_;
+  
+  // Layer buffers, allocated while enabled; the content buffer only while
+  // another layer is on (otherwise content is drawn into frame_buffer_)
+  uint8_t* layer_buffers_[LAYER_COUNT];
+  BlendMode layer_blend_[LAYER_COUNT];
+  uint8_t layer_alpha_[LAYER_COUNT];
+  bool layer_enabled_[LAYER_COUNT];
+  uint8_t* compose_buffer_;
+  Layer draw_layer_;
+  bool layers_active_;
+  bool layers_changed_;   // A layer was drawn on since the last composite
+  
+  // Single-slot handoff to the flush tasks: the render core sets it to the
+  // number of bus tasks after filling the front buffer, each task decrements
+  // it once its boards are transmitted - the frame is done at zero, and the
+  // task that gets it there gives flush_done_ to wake waitForFlush()
+  std::atomic<int> flushes_pending_;
+  SemaphoreHandle_t flush_done_;
+  bool async_flush_;
+  struct FlushTask {
+    DisplayManager* owner;
+    int bus;
+    TaskHandle_t handle;
+  };
+  FlushTask flush_tasks_[MAX_BUSES];
+  
+  uint8_t master_brightness_;       // Software scale applied to PWM values
   
   // Internal helper methods
-  void initializeDrivers();
-  void convertLogicalToPhysical(int logical_x, int logical_y, int& physical_x, int& physical_y);
+  void assignDefaultBoards();
+  bool findSharedAddress(int& first, int& second) const;  // Two boards one chip would answer for
+  void markAllBoardsDirty();
+  void invalidateBoard(int board);
+  void composeLayers();
+  uint8_t* drawBuffer() const { return layers_active_ ? layer_buffers_[draw_layer_] : frame_buffer_; }
+  void markAllDrawn() {
+    buffer_version_++;
+    if (layers_active_) {
+      layers_changed_ = true;
+    } else {
+      markAllBoardsDirty();
+    }
+  }
+  void markDrawn(int index) {
+    buffer_version_++;
+    if (layers_active_) {
+      layers_changed_ = true;  // The boards are marked when the layers are composited
+      return;
+    }
+    uint8_t board = layout_.table()[index].board;
+    if (board != PanelLayout::NO_BOARD) {
+      board_dirty_[board] = true;
+    }
+  }
+  void transmitFrame(const uint8_t* frame, bool* dirty, int bus);
+  static void flushTaskEntry(void* arg);
   
   // Helper methods for display information
   uint8_t getI2CAddressFromADDR(ADDR addr) const;
@@ -0,0 +1,40 @@
+#ifndef EFFECT_H
+#define EFFECT_H
+
+#include <stdint.h>
+
+// An ambient effect that renders whole frames. It does not touch the
+// display: EffectRegistry paces it, hands it a frame to draw into and
+// sends the result. init() is where an effect allocates; update() and
+// render() should not.
+class Effect {
+public:
+  virtual ~Effect() {}
+
+  virtual const char* getName() const = 0;
+
+  // Prepare for width x height frames. Returns false if the effect can't run
+  // (e.g. out of memory); it is not registered then.
+  virtual bool init(int width, int height) = 0;
+
+  // Advance by elapsed_ms. After skipped frames this covers several frame
+  // intervals, so motion keeps its speed.
+  virtual void update(uint32_t elapsed_ms) = 0;
+
+  // Draw the current state into a row-major width x height frame, one byte
+  // per pixel. Every pixel must be written.
+  virtual void render(uint8_t* frame) = 0;
+
+  virtual uint8_t getTargetFps() const = 0;
+
+  // Called again when selected, e.g. to restart from a fresh state
+  virtual void reset() {}
+
+  // Cheaper rendering for effects that are over their time budget: level 0
+  // is full detail, up to getMaxDetailLevel(). Effects without cheaper
+  // modes only get frame-skipped.
+  virtual uint8_t getMaxDetailLevel() const { return 0; }
+  virtual void setDetailLevel(uint8_t level) { (void)level; }
+};
+
+#endif // EFFECT_H
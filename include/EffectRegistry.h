@@ -0,0 +1,74 @@
+#ifndef EFFECT_REGISTRY_H
+#define EFFECT_REGISTRY_H
+
+#include <Arduino.h>
+#include "Effect.h"
+
+class DisplayManager;
+
+// The ambient effects main.cpp can cycle through, and the runtime that
+// drives the selected one. Each frame is timed; an effect that takes more
+// than its share of the frame interval first gets its detail lowered, then
+// frames skipped (it is updated with the longer elapsed time instead), so
+// a slow effect never holds up the loop. Effects are not owned.
+class EffectRegistry {
+public:
+  static const int MAX_EFFECTS = 16;
+  static const uint8_t MAX_SKIP = 3;  // At most every 4th frame is drawn
+
+  struct Stats {
+    uint32_t render_us_last;   // update() + render() of the last frame
+    uint32_t render_us_avg;    // Smoothed over the last few frames
+    uint32_t budget_us;        // What the current frame period allows
+    uint32_t frames_drawn;
+    uint32_t frames_skipped;
+    uint8_t skip;              // Frames skipped per frame drawn
+    uint8_t detail_level;      // 0 = full detail
+  };
+
+  explicit EffectRegistry(DisplayManager* display_manager);
+  ~EffectRegistry();
+
+  // Initializes the effect for the display size and appends it. Returns its
+  // index, or -1 when the registry is full or init() failed.
+  int add(Effect* effect);
+  int getCount() const { return count_; }
+  Effect* get(int index) const { return (index >= 0 && index < count_) ? effects_[index] : nullptr; }
+  int find(const char* name) const;
+
+  // Make an effect current (-1 = none) and restart its pacing and budget
+  void select(int index);
+  int getSelected() const { return selected_; }
+
+  // Share of each frame interval the effect may spend, in percent. The rest
+  // is left for flushing and everything else in the loop. Default 50.
+  void setBudgetPercent(uint8_t percent) { budget_percent_ = percent; }
+
+  // Call every loop. Draws and sends a frame of the selected effect when
+  // one is due; returns true if it did.
+  bool update();
+
+  const Stats& getStats() const { return stats_; }
+
+private:
+  DisplayManager* display_manager_;
+  Effect* effects_[MAX_EFFECTS];
+  int count_;
+  int selected_;
+  uint8_t* frame_;
+  uint8_t budget_percent_;
+  unsigned long last_frame_;
+  bool started_;
+  uint8_t frames_since_adjust_;
+  Stats stats_;
+
+  uint32_t periodMs(uint8_t skip) const;
+  uint32_t budgetUs(uint8_t skip) const;
+  void adjustBudget();
+
+  // Non-copyable (owns the frame)
+  EffectRegistry(const EffectRegistry&);
+  EffectRegistry& operator=(const EffectRegistry&);
+};
+
+#endif // EFFECT_REGISTRY_H
@@ -0,0 +1,28 @@
+#ifndef FILE_TEXT_SOURCE_H
+#define FILE_TEXT_SOURCE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "TextSource.h"
+
+// Text streamed from a file (e.g. on LittleFS) - only the controller's
+// read-ahead window is ever in RAM, so book-length text costs nothing extra
+class FileTextSource : public TextSource {
+public:
+  FileTextSource();
+  ~FileTextSource();
+
+  bool open(fs::FS& fs, const char* path);
+  void close();
+  bool isOpen() const { return open_; }
+
+  int read(uint32_t position, char* out, int count) override;
+  uint32_t length() const override { return length_; }
+
+private:
+  fs::File file_;
+  uint32_t length_;
+  bool open_;
+};
+
+#endif // FILE_TEXT_SOURCE_H
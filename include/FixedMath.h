@@ -0,0 +1,50 @@
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <stdint.h>
+
+// 8-bit fixed-point helpers for per-pixel effects: table lookups and
+// integer arithmetic only, no floats. Angles are 0-255 for a full turn;
+// fractions are n / 256.
+class FixedMath {
+public:
+  static const uint8_t SIN8_TABLE[256];
+  static const uint8_t GAMMA8_TABLE[256];
+
+  // Sine and cosine of angle (256 = full turn), 128 +/- 127
+  static uint8_t sin8(uint8_t angle) { return SIN8_TABLE[angle]; }
+  static uint8_t cos8(uint8_t angle) { return SIN8_TABLE[(uint8_t)(angle + 64)]; }
+
+  // value * scale / 256, with scale 255 leaving 255 at 255
+  static uint8_t scale8(uint8_t value, uint8_t scale) {
+    return (uint8_t)(((uint16_t)value * (uint16_t)(scale + 1)) >> 8);
+  }
+
+  // From a towards b by fraction / 256
+  static uint8_t lerp8(uint8_t a, uint8_t b, uint8_t fraction) {
+    return (uint8_t)(a + (((int)b - (int)a) * fraction >> 8));
+  }
+
+  // Perceived brightness to LED level (gamma 2.2)
+  static uint8_t gamma8(uint8_t value) { return GAMMA8_TABLE[value]; }
+
+  // Smooth S-curve (3f^2 - 2f^3) for easing fractions
+  static uint8_t ease8(uint8_t fraction) {
+    uint32_t f = fraction;
+    return (uint8_t)((f * f * (768 - 2 * f)) >> 16);
+  }
+
+  // Saturating add and subtract
+  static uint8_t qadd8(uint8_t a, uint8_t b) { int sum = a + b; return sum > 255 ? 255 : sum; }
+  static uint8_t qsub8(uint8_t a, uint8_t b) { return a > b ? a - b : 0; }
+
+  // Pseudo-random value for an integer lattice point
+  static uint8_t hash8(uint16_t x, uint16_t y);
+
+  // Smooth value noise. Coordinates are 8.8 fixed point: the high byte
+  // picks the lattice cell, the low byte is the position inside it. The
+  // 256-cell lattice wraps, so a coordinate overflowing 16 bits is seamless.
+  static uint8_t noise8(uint16_t x, uint16_t y);
+};
+
+#endif // FIXED_MATH_H
@@ -0,0 +1,25 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+
+// Minimal I2C master interface the board chain talks through. The firmware
+// wraps TwoWire (WireBus); host tests substitute a mock.
+class I2CBus {
+public:
+  virtual ~I2CBus() {}
+
+  // One write transaction: register byte followed by `length` data bytes
+  virtual bool writeRegisters(uint8_t address, uint8_t start_register, const uint8_t* data, int length) = 0;
+
+  // One write transaction carrying a single byte (register-less devices like a mux)
+  virtual bool writeByte(uint8_t address, uint8_t value) = 0;
+
+  // Address-only transaction - true if a device acknowledged
+  virtual bool probe(uint8_t address) = 0;
+
+  // Longest data payload a single writeRegisters() call can carry
+  virtual int maxWriteLength() const = 0;
+};
+
+#endif // I2C_BUS_H
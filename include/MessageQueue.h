@@ -0,0 +1,87 @@
+#ifndef MESSAGE_QUEUE_H
+#define MESSAGE_QUEUE_H
+
+#include <Arduino.h>
+#include "SignTextController.h"
+
+namespace RetroText {
+
+// Message priorities - a higher one interrupts a lower one on screen
+enum MessagePriority {
+  PRIORITY_BACKGROUND = 0,
+  PRIORITY_NORMAL = 1,
+  PRIORITY_ALERT = 2,
+  PRIORITY_URGENT = 3
+};
+
+// Plays queued messages on one SignTextController without blocking.
+// Messages are shown highest priority first, oldest first within a
+// priority. A higher-priority message interrupts the one on screen, which
+// goes back into the queue and later resumes at its saved scroll position.
+class MessageQueue {
+public:
+  static const uint32_t DEFAULT_STATIC_MS = 2000;  // STATIC messages queued without a duration
+
+  // The queue sets the sign's message and style; other settings (font,
+  // speed, style rule) stay as configured
+  explicit MessageQueue(SignTextController* sign, int capacity = 8);
+  ~MessageQueue();
+
+  // Queue a message. duration_ms is how long a STATIC message stays up
+  // (0 = DEFAULT_STATIC_MS), or for SMOOTH and CHARACTER how long to hold
+  // the last frame after scrolling through (0 = move on at once). A LOOP
+  // message plays for duration_ms, or until cleared or preempted if 0.
+  // Returns false when the queue is full.
+  bool enqueue(const String& text, uint8_t priority = PRIORITY_NORMAL,
+               ScrollStyle style = SMOOTH, uint32_t duration_ms = 0);
+
+  // Call every loop: preempts, advances the sign and, when the message on
+  // screen is done, starts and draws the next one in the same call. Returns
+  // true while a message has the display.
+  bool update();
+
+  void clear();                  // Drop everything, including the message on screen
+  bool isIdle() const;           // Nothing on screen and nothing waiting
+  bool isShowing() const { return active_ >= 0; }
+  int getPendingCount() const;   // Waiting messages, interrupted ones included
+  uint8_t getCurrentPriority() const;  // Of the message on screen; 0 when none
+
+private:
+  struct Entry {
+    String text;
+    uint8_t priority;
+    ScrollStyle style;
+    uint32_t duration_ms;
+    uint32_t sequence;       // Enqueue order, keeps FIFO within a priority
+    uint32_t shown_ms;       // Screen time used before being interrupted
+    uint32_t held_ms;        // Final-frame hold used before being interrupted
+    int resume_pixels;       // Scroll position saved when interrupted
+    uint8_t resume_fraction; // 1/256 pixels past resume_pixels
+    int resume_chars;
+    bool interrupted;
+    bool used;
+  };
+
+  SignTextController* sign_;
+  Entry* entries_;
+  int capacity_;
+  int active_;               // Entry on screen, -1 = none
+  uint32_t next_sequence_;
+  unsigned long started_at_; // When the entry on screen was (re)started
+  bool scrolled_through_;    // The entry on screen has completed its scroll
+  unsigned long scrolled_through_at_;
+
+  int pickNext() const;
+  void start(int index);
+  void advance();            // Update the sign and note when it completes
+  void suspend();
+  bool isActiveDone() const;
+
+  // Non-copyable (owns the entries)
+  MessageQueue(const MessageQueue&);
+  MessageQueue& operator=(const MessageQueue&);
+};
+
+} // namespace RetroText
+
+#endif // MESSAGE_QUEUE_H
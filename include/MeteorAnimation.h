@@ -3,8 +3,12 @@
 
 #include <Arduino.h>
 #include "DisplayManager.h"
+#include "ParticleSystem.h"
+#include "Effect.h"
 
-class MeteorAnimation {
+// Meteors with parallax stars. Runs on its own (initialize() + update(),
+// which draws and paces itself) or as an Effect driven by EffectRegistry.
+class MeteorAnimation : public Effect {
 public:
   // Constructor
   MeteorAnimation(DisplayManager* display_manager);
@@ -15,14 +19,24 @@ public:
   // Animation control
   void initialize();
   void update();
-  void reset();
+  void reset() override;
+  
+  // Effect - the registry paces frames; steps follow the elapsed time
+  const char* getName() const override { return "Meteor Animation"; }
+  bool init(int width, int height) override;
+  void update(uint32_t elapsed_ms) override;
+  void render(uint8_t* frame) override;
+  uint8_t getTargetFps() const override { return fps_; }
   
   // Configuration
   void setNumMeteors(int num_meteors);
   void setNumStars(int num_stars);
-  void setFrameRate(int fps);
+  void setFrameRate(int fps);   // Clamped to 1-250
   void setBrightness(uint8_t meteor_brightness, uint8_t star_brightness_fast, uint8_t star_brightness_slow);
   void setSpeed(float meteor_speed_multiplier, float star_speed_multiplier);
+  // Draw the stars on the display's background layer and the meteors on its
+  // overlay, leaving the content layer to other drawing (e.g. scrolling text)
+  void setLayered(bool layered);
   
   // Animation state
   bool isRunning() const { return running_; }
@@ -36,29 +50,35 @@ private:
   // Configuration
   int num_meteors_;
   int num_stars_;
-  unsigned long frame_interval_;  // ms between frames
+  uint8_t fps_;
+  unsigned long frame_interval_;  // ms between frames, 1000 / fps_
   uint8_t meteor_brightness_;
   uint8_t star_brightness_fast_;
   uint8_t star_brightness_slow_;
   float meteor_speed_multiplier_;
   float star_speed_multiplier_;
+  bool layered_;
   
   // Animation state
   bool initialized_;
   bool running_;
   unsigned long last_update_;
   unsigned long frame_count_;
+  uint32_t pending_ms_;   // Elapsed time not yet stepped (Effect mode)
   
-  // Animation data
-  float* meteor_positions_;
-  float* star_positions_;
+  // Animation data - stars and meteors are two particle systems, drawn
+  // into frame_ and blended onto the display. All allocated in initialize().
+  ParticleSystem* stars_;
+  ParticleSystem* meteors_;
+  uint8_t* frame_;
   
   // Internal methods
   void initializePositions();
-  void updateMeteors();
-  void updateStars();
-  void drawMeteors();
-  void drawStars();
+  void applySettings();
+  int16_t starVelocity(int index) const;
+  int16_t meteorVelocity(int index) const;
+  uint8_t starBrightness(int index) const;
+  void presentLayer(DisplayManager::Layer layer, const ParticleSystem* particles);
   void cleanup();
 };
 
@@ -0,0 +1,83 @@
+#ifndef PANEL_LAYOUT_H
+#define PANEL_LAYOUT_H
+
+#include <stdint.h>
+
+// Orientation of a board's 24x6 pixel area within the logical display
+enum class BoardRotation : uint8_t {
+  ROTATE_0 = 0,
+  ROTATE_90 = 1,    // Quarter turn clockwise (footprint becomes 6 wide, 24 tall)
+  ROTATE_180 = 2,   // Upside down - how the stock RetroText chain is mounted
+  ROTATE_270 = 3
+};
+
+// Declarative description of where one board sits in the logical display
+struct BoardPlacement {
+  uint8_t board;            // Driver index the pixels are sent to
+  int16_t x;                // Top-left corner of the board's footprint
+  int16_t y;
+  BoardRotation rotation;
+  bool mirror;              // Mirror the footprint horizontally (before rotation)
+};
+
+// Where a logical pixel lives in hardware: board index plus the
+// IS31FL3737 matrix position (x = CS column 0-11, y = SW row 0-11)
+// and the PWM register that holds its brightness
+struct PhysicalPixel {
+  uint8_t board;
+  uint8_t x;
+  uint8_t y;
+  uint8_t pwm_register;
+};
+
+// Compiles a list of board placements into a logical-to-physical lookup table.
+// The table is built once, so per-pixel work is a single array index.
+class PanelLayout {
+public:
+  static const uint8_t NO_BOARD = 0xFF;  // Logical pixel not covered by any board
+  static const int PWM_PAGE_SIZE = 0xC0; // IS31FL3737 PWM registers 00h-BFh
+
+  PanelLayout();
+  ~PanelLayout();
+
+  // Build the table for a width x height display from board placements.
+  // Returns false if a placement falls outside the display or boards overlap.
+  // A placement naming a board >= num_boards is rejected before anything is
+  // built, so the previous table stays in use.
+  bool build(const BoardPlacement* placements, int count, int num_boards, int width, int height,
+             int board_width = 24, int board_height = 6);
+
+  // Fill `out` with the stock RetroText chain: boards side by side, rotated
+  // 180 degrees, board 0 on the right. Returns the number of placements.
+  static int defaultChain(int num_boards, int board_width, int board_height, BoardPlacement* out);
+
+  // Stock chains stacked into rows: board_rows rows of `columns` boards,
+  // row 0 on top, each row laid out like defaultChain(). Returns the count.
+  static int defaultGrid(int columns, int board_rows, int board_width, int board_height, BoardPlacement* out);
+
+  // Fold a board-local 24x6 position onto the 12x12 driver matrix
+  // (characters 0-2 on SW1-6, characters 3-5 on SW7-12, see doc/PCB_Layout.md)
+  static void foldToMatrix(int local_x, int local_y, uint8_t& matrix_x, uint8_t& matrix_y);
+
+  // PWM register for a matrix position: 16 registers per SW row, and the
+  // IS31FL3737 skips offsets 6-7 so CS7-12 land on 08h-0Dh
+  static uint8_t pwmRegister(uint8_t matrix_x, uint8_t matrix_y) {
+    return matrix_y * 16 + (matrix_x < 6 ? matrix_x : matrix_x + 2);
+  }
+
+  const PhysicalPixel& lookup(int x, int y) const { return table_[y * width_ + x]; }
+  const PhysicalPixel* table() const { return table_; }
+  int getWidth() const { return width_; }
+  int getHeight() const { return height_; }
+
+private:
+  int width_;
+  int height_;
+  PhysicalPixel* table_;
+
+  // Non-copyable (owns the table)
+  PanelLayout(const PanelLayout&);
+  PanelLayout& operator=(const PanelLayout&);
+};
+
+#endif // PANEL_LAYOUT_H
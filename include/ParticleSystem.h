@@ -0,0 +1,81 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <stdint.h>
+#include "Xorshift32.h"
+
+// Fixed-capacity particle engine for effects such as meteors, stars and
+// sparks. State is kept as structure-of-arrays in fixed point: positions
+// and velocities are in 1/256 pixel (Q8.8, positions widened to 32 bits so
+// long chains fit). Everything is allocated in the constructor; spawning
+// and stepping never allocate.
+class ParticleSystem {
+public:
+  static const int FRACTION_BITS = 8;
+  static const int32_t ONE = 1 << FRACTION_BITS;   // One pixel
+
+  // What happens to a particle that leaves the bounds
+  enum EdgeMode {
+    EDGE_WRAP = 0,   // Re-enter from the opposite edge
+    EDGE_KILL = 1    // Removed
+  };
+
+  explicit ParticleSystem(int capacity, uint32_t seed = 1);
+  ~ParticleSystem();
+
+  // Area particles live in, in whole pixels (max exclusive)
+  void setBounds(int min_x, int min_y, int max_x, int max_y, EdgeMode mode);
+
+  // Add a particle; x, y, vx, vy in 1/256 pixel (per step for velocities).
+  // It draws as a head plus trail_length - 1 pixels behind it, each
+  // trail_decay dimmer than the one before. lifetime_steps 0 = never expires.
+  // Returns its index, or -1 when the system is full.
+  int spawn(int32_t x, int32_t y, int16_t vx, int16_t vy, uint8_t brightness,
+            uint8_t trail_length = 1, uint8_t trail_decay = 0, uint16_t lifetime_steps = 0);
+  void clear() { count_ = 0; }
+
+  // Advance every particle one step. Expired particles and particles that
+  // leave the bounds with EDGE_KILL are removed: the last particle moves into
+  // the freed index, so indexes are stable only while nothing is removed.
+  void step();
+
+  // Draw into a row-major frame (width x height), keeping the brighter of
+  // the particle and what is already there
+  void render(uint8_t* frame, int width, int height) const;
+
+  int getCount() const { return count_; }
+  int getCapacity() const { return capacity_; }
+  int32_t getX(int index) const { return x_[index]; }
+  int32_t getY(int index) const { return y_[index]; }
+  void setVelocity(int index, int16_t vx, int16_t vy) { vx_[index] = vx; vy_[index] = vy; }
+  void setBrightness(int index, uint8_t brightness) { brightness_[index] = brightness; }
+
+  uint32_t random() { return rng_.next(); }
+  int random(int min, int max);   // min <= n < max
+
+private:
+  int capacity_;
+  int count_;
+  Xorshift32 rng_;
+
+  int32_t min_x_, min_y_, max_x_, max_y_;   // 1/256 pixel
+  EdgeMode edge_mode_;
+
+  // One array per field
+  int32_t* x_;
+  int32_t* y_;
+  int16_t* vx_;
+  int16_t* vy_;
+  uint8_t* brightness_;
+  uint8_t* trail_length_;
+  uint8_t* trail_decay_;
+  uint16_t* lifetime_;    // Steps left; 0 = never expires
+
+  void remove(int index);
+
+  // Non-copyable (owns the arrays)
+  ParticleSystem(const ParticleSystem&);
+  ParticleSystem& operator=(const ParticleSystem&);
+};
+
+#endif // PARTICLE_SYSTEM_H
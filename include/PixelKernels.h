@@ -0,0 +1,38 @@
+#ifndef PIXEL_KERNELS_H
+#define PIXEL_KERNELS_H
+
+#include <stdint.h>
+
+// Fixed-point inner loops over framebuffer rows and pre-rasterized column
+// strips. The whole-buffer kernels work 4 pixels per 32-bit word (SWAR) when their
+// buffers are 4-byte aligned (new[] buffers are), a byte at a time otherwise.
+class PixelKernels {
+public:
+  // Per-column weights for a sub-pixel blend of a column strip. Output
+  // column i mixes strip columns i and i+1 as (256 - fraction) / 256 and
+  // fraction / 256 of their levels, so left[i] + right[i] never exceeds
+  // 255. Columns past `count` weigh 0. `left` and `right` hold `width` entries.
+  static void blendWeights(const uint8_t* levels, int count, int width, uint8_t fraction,
+                           uint8_t* left, uint8_t* right);
+
+  // One row of the blend: out[i] = left[i] if row bit i is set, plus
+  // right[i] if row bit i + 1 is set. Branch-free, two masked adds per pixel.
+  static void blendRow(const uint8_t* masks, int count, int width, int row,
+                       const uint8_t* left, const uint8_t* right, uint8_t* out);
+
+  // Set every pixel; true if any pixel changed
+  static bool fill(uint8_t* dst, int count, uint8_t value);
+  // Decay every pixel by amount / 256 of its level (trails, fade to black);
+  // true if any pixel changed
+  static bool fade(uint8_t* dst, int count, uint8_t amount);
+
+  // Layer compositing: combine `count` pixels of src into dst. A src pixel
+  // of 0 leaves dst unchanged in every mode.
+  static void composeReplace(uint8_t* dst, const uint8_t* src, int count);   // Masked blit: lit src replaces dst
+  static void composeAdd(uint8_t* dst, const uint8_t* src, int count);       // Saturates at 255
+  static void composeMax(uint8_t* dst, const uint8_t* src, int count);
+  // Lit src mixed over dst: dst + (src - dst) * alpha / 256
+  static void composeAlpha(uint8_t* dst, const uint8_t* src, int count, uint8_t alpha);
+};
+
+#endif // PIXEL_KERNELS_H
@@ -0,0 +1,72 @@
+#ifndef SHADER_EFFECT_H
+#define SHADER_EFFECT_H
+
+#include <stdint.h>
+#include "Effect.h"
+#include "FixedMath.h"
+
+// An effect written as a function of (x, y, t) returning each pixel's
+// brightness, t being milliseconds since the effect started. evaluate()
+// runs it over a whole frame; DisplayManager::shade() does the same into
+// the display. Shaders use FixedMath, not floats.
+class ShaderEffect : public Effect {
+public:
+  typedef uint8_t (*PixelShader)(int x, int y, uint32_t t);
+
+  static const uint8_t MAX_DETAIL_LEVEL = 2;   // Every 4th column evaluated
+
+  ShaderEffect(const char* name, PixelShader shader, uint8_t fps = 50);
+
+  const char* getName() const override { return name_; }
+  bool init(int width, int height) override;
+  void update(uint32_t elapsed_ms) override { time_ms_ += elapsed_ms; }
+  void render(uint8_t* frame) override;
+  uint8_t getTargetFps() const override { return fps_; }
+  void reset() override { time_ms_ = 0; }
+
+  // Lower detail evaluates every 2nd (level 1) or 4th (level 2) column and
+  // repeats it - soft effects barely change
+  uint8_t getMaxDetailLevel() const override { return MAX_DETAIL_LEVEL; }
+  void setDetailLevel(uint8_t level) override { detail_level_ = level; }
+
+  // Fill a row-major width x height frame with shader(x, y, t), evaluating
+  // every column_step-th column. Shader is a PixelShader or a lambda; a
+  // lambda is inlined into the loop.
+  template <typename Shader>
+  static void evaluate(Shader shader, uint8_t* frame, int width, int height, uint32_t t,
+                       int column_step = 1) {
+    for (int y = 0; y < height; y++) {
+      uint8_t* row = frame + y * width;
+      if (column_step <= 1) {
+        for (int x = 0; x < width; x++) {
+          row[x] = shader(x, y, t);
+        }
+        continue;
+      }
+      for (int x = 0; x < width; x += column_step) {
+        uint8_t value = shader(x, y, t);
+        int end = x + column_step < width ? x + column_step : width;
+        for (int i = x; i < end; i++) {
+          row[i] = value;
+        }
+      }
+    }
+  }
+
+  // Built-in shaders
+  static uint8_t plasma(int x, int y, uint32_t t);     // Interfering sine fields
+  static uint8_t waves(int x, int y, uint32_t t);      // A sine line rolling along each board row
+  static uint8_t gradient(int x, int y, uint32_t t);   // Soft bands drifting sideways
+  static uint8_t clouds(int x, int y, uint32_t t);     // Value noise drifting past
+
+private:
+  const char* name_;
+  PixelShader shader_;
+  uint8_t fps_;
+  uint8_t detail_level_;
+  int width_;
+  int height_;
+  uint32_t time_ms_;
+};
+
+#endif // SHADER_EFFECT_H
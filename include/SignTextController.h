@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <functional>
+#include "TextSource.h"
 
 // Forward declaration
 class DisplayManager;
@@ -19,7 +20,14 @@ enum Font {
 enum ScrollStyle {
   SMOOTH = 0,
   CHARACTER = 1,
-  STATIC = 2
+  STATIC = 2,
+  LOOP = 3        // Smooth marquee that never ends: tail, gap, head
+};
+
+// Scroll velocity profile
+enum ScrollEasing {
+  EASE_LINEAR = 0,     // Constant velocity
+  EASE_IN_OUT = 1      // Accelerate from rest, decelerate into the end of the message
 };
 
 // Brightness levels
@@ -38,6 +46,60 @@ struct HighlightSpan {
   bool active;
 };
 
+// Per-character styling, computed once per message
+struct CharAttributes {
+  uint8_t brightness;
+  uint8_t flags;        // Reserved for future styling, currently 0
+};
+
+// Styling rule, run over the read-ahead window each time the window is
+// refilled, not over the whole message. apply() gets a run of `length`
+// characters starting at message position `start` (of `message_length`),
+// with one attribute entry per character pre-filled with the default
+// brightness, and overwrites what it wants to style. Runs start and end
+// on word boundaries unless a word is longer than the window; LOOP text
+// is passed one repetition at a time.
+class TextStyleRule {
+public:
+  virtual ~TextStyleRule() {}
+  virtual void apply(const char* text, int length, uint32_t start, uint32_t message_length,
+                     CharAttributes* attributes) = 0;
+};
+
+// Words with capitals and no lowercase letters are bright, digits normal,
+// everything else dim - the stock news ticker look
+class CapitalizedWordRule : public TextStyleRule {
+public:
+  CapitalizedWordRule(uint8_t capitalized, uint8_t digits, uint8_t other)
+    : capitalized_(capitalized), digits_(digits), other_(other) {}
+  void apply(const char* text, int length, uint32_t start, uint32_t message_length,
+             CharAttributes* attributes) override;
+
+private:
+  uint8_t capitalized_;
+  uint8_t digits_;
+  uint8_t other_;
+};
+
+// The last `span_length` characters get one brightness, the rest another
+// (e.g. the time at the end of the clock line)
+class TrailingSpanRule : public TextStyleRule {
+public:
+  TrailingSpanRule(int span_length, uint8_t span_brightness, uint8_t rest_brightness)
+    : span_length_(span_length), span_brightness_(span_brightness), rest_brightness_(rest_brightness) {}
+  void setBrightness(uint8_t span_brightness, uint8_t rest_brightness) {
+    span_brightness_ = span_brightness;
+    rest_brightness_ = rest_brightness;
+  }
+  void apply(const char* text, int length, uint32_t start, uint32_t message_length,
+             CharAttributes* attributes) override;
+
+private:
+  int span_length_;
+  uint8_t span_brightness_;
+  uint8_t rest_brightness_;
+};
+
 class SignTextController {
 public:
   // Constructor
@@ -49,17 +111,43 @@ public:
   // Configuration methods
   void setFont(Font font);
   void setScrollStyle(ScrollStyle style);
-  void setScrollSpeed(int speed_ms);
+  void setScrollSpeed(int speed_ms);          // Time per step (pixel or character); 0 = one step per update()
+  void setScrollVelocity(float pixels_per_second);
+  float getScrollVelocity() const;            // 0 when stepping once per update()
+  void setScrollEasing(ScrollEasing easing, int ramp_ms = 500);
+  void setSubpixelScroll(bool enabled);       // SMOOTH/LOOP with a DisplayManager: blend between pixel steps
+  void setLoopGap(int blank_characters);      // LOOP: blank cells between the tail and the head
   void setBrightness(uint8_t default_brightness);
   void setCharacterSpacing(int spacing_pixels);  // Set spacing between characters for smooth scroll
+  void setStyleRule(TextStyleRule* rule);        // Not owned; nullptr = default brightness
   
   // Message control
   void setMessage(String message);
-  String getMessage() const;
+  String getMessage() const;              // Empty when a TextSource is set
+  
+  // Stream text from a source instead (not owned). Only a small window
+  // around the visible characters is read, so memory use does not depend
+  // on text length. Live sources keep scrolling as text is appended.
+  void setSource(TextSource* source);
+  TextSource* getSource() const { return source_; }
+  uint32_t getMessageLength() const;
+  
+  // Live ticker: add to or patch the text while it keeps scrolling. The
+  // first call moves the current message into an owned RingTextSource at
+  // the same positions (a caller's own source starts over empty); the
+  // oldest text is dropped once the buffer is full. Only the new or
+  // changed characters are rasterized.
+  void setLiveCapacity(int characters);  // Before the first append, default 512; a carried-over message adds its length
+  void appendText(const char* text, int count);
+  void appendText(const String& text);
+  int replaceText(uint32_t position, const char* text, int count);  // Returns characters changed
+  int replaceText(uint32_t position, const String& text);
+  void finishText();                     // No more text - the scroll may complete
   
   // Scroll position control
   void setScrollChars(int char_position);
-  void setScrollPixels(int pixel_offset);
+  void setScrollPixels(int pixel_offset) { setScrollPixels(pixel_offset, 0); }
+  void setScrollPixels(int pixel_offset, uint8_t fraction);  // Plus 1/256 pixels, kept only with sub-pixel scrolling
   void resetScroll();
   
   // Highlight control
@@ -70,26 +158,55 @@ public:
   void update();
   bool isComplete() const;
   void reset();
+  void redraw();  // Send the frame again on the next update(), e.g. after other code drew over it
+  void setRepeat(bool repeat);  // Start over on the same update() a scroll completes
+  
+  // Exact time from the first frame to isComplete() at the current speed,
+  // easing and message length; 0 when the message fits (shown static at
+  // once) or when stepping once per update(). For LOOP, the time per pass.
+  uint32_t estimatedDurationMs() const;
+  
+  // Events, called from update(): on-complete when a scroll reaches its end
+  // (every pass when repeating), on-wrap when a repeating scroll starts over
+  // or a LOOP passes the head of the message
+  typedef std::function<void()> EventCallback;
+  void setOnComplete(EventCallback callback) { on_complete_ = callback; }
+  void setOnWrap(EventCallback callback) { on_wrap_ = callback; }
   
   // Status methods
   int getCurrentCharPosition() const;
   int getCurrentPixelOffset() const;
+  uint8_t getSubpixelOffset() const { return scroll_fraction_; }  // 1/256 pixel past getCurrentPixelOffset()
   bool isScrolling() const;
   ScrollStyle getScrollStyle() const;
+  uint32_t getSkippedSteps() const { return skipped_steps_; }  // Steps never shown because update() was late
   
   // Direct DisplayManager integration (preferred method)
   void setDisplayManager(::DisplayManager* display_manager);
+  // Region of the display this controller draws: display_width_chars wide
+  // and 6 rows high from (x, y), clipped to it. Defaults to (0, 0).
+  void setViewport(int x, int y = 0);
+  int getViewportWidth() const { return display_width_pixels_; }
+  // False = only draw into the frame and leave present() to the caller
+  // (a ZoneCompositor sharing the display between controllers)
+  void setAutoPresent(bool enabled) { auto_present_ = enabled; }
+  // True = STATIC cells are redrawn only after redraw(), not whenever the
+  // display buffer changed, because whoever shares the display (a
+  // ZoneCompositor) tracks what else drew on it
+  void setSharedDisplay(bool shared) { shared_display_ = shared; }
+  // DisplayManager::getBufferVersion() steps caused by this controller's drawing
+  uint32_t getDrawCount() const { return draw_count_; }
   
   // Callback for actual display rendering (legacy method)
   typedef std::function<void(uint8_t character, int pixel_offset, uint8_t brightness, bool use_alt_font)> RenderCallback;
   typedef std::function<void()> ClearCallback;
   typedef std::function<void()> DrawCallback;
-  typedef std::function<uint8_t(char c, String text, int char_pos, bool is_time_display)> BrightnessCallback;
+  typedef std::function<uint8_t(char c, const String& text, int char_pos, bool is_time_display)> BrightnessCallback;
   
   void setRenderCallback(RenderCallback callback);
   void setClearCallback(ClearCallback callback);
   void setDrawCallback(DrawCallback callback);
-  void setBrightnessCallback(BrightnessCallback callback);
+  void setBrightnessCallback(BrightnessCallback callback);  // Legacy - prefer setStyleRule()
 
 private:
   // Helper methods
@@ -106,38 +223,122 @@ private:
   Font current_font_;
   ScrollStyle scroll_style_;
   int scroll_speed_ms_;
+  float scroll_velocity_;    // Pixels per second; overrides scroll_speed_ms_ when > 0
+  ScrollEasing scroll_easing_;
+  int scroll_ramp_ms_;
+  bool subpixel_scroll_;
+  int loop_gap_chars_;
   uint8_t default_brightness_;
   
-  // Message data
+  // Message data - setMessage() keeps the String and streams it through
+  // message_source_ like any other source
   String message_;
+  TextSource* source_;
+  MemoryTextSource message_source_;
+  RingTextSource* live_source_;   // Owned, created by the first appendText()/replaceText()
+  int live_capacity_;
+  
+  // Read-ahead window: the source characters around the visible part,
+  // refilled from the source only when scrolling leaves it
+  static const int WINDOW_HISTORY = 16;      // Characters read behind the visible start, back to a word start
+  static const int WINDOW_READ_AHEAD = 32;   // Characters read past the visible end
+  char* window_text_;
+  int window_capacity_;
+  uint32_t window_start_;   // Source position of window_text_[0]
+  int window_count_;
+  bool window_valid_;
+  uint32_t loop_length_;    // LOOP: message length the window was read with
   
-  // Scroll state
+  // Scroll state - the position is a function of time since the origin,
+  // so late frames skip ahead instead of slowing the message down
   int scroll_char_position_;
   int scroll_pixel_offset_;
-  unsigned long last_update_time_;
+  uint8_t scroll_fraction_;  // Sub-pixel part of the offset, 8.8 fixed point
+  unsigned long scroll_origin_time_;
+  int64_t scroll_origin_step_;   // Position (pixels, 1/256 pixels or characters) at scroll_origin_time_
+  bool scroll_anchored_;     // False until the next update() sets the origin
+  bool scroll_ramp_in_;      // The origin is a real start, so easing ramps up from it
   bool scroll_complete_;
+  bool repeat_;
+  uint32_t skipped_steps_;
+  
+  // Last frame sent to the display, to skip redundant renders
+  bool frame_valid_;
+  int rendered_offset_;
+  uint8_t rendered_fraction_;
+  uint32_t rendered_length_;
   
   // Highlighting
   static const int MAX_HIGHLIGHTS = 4;
   HighlightSpan highlights_[MAX_HIGHLIGHTS];
   
+  // Styling: attributes_ holds one entry per window character, rebuilt
+  // from the rule and highlights only when one of them or the window changes
+  TextStyleRule* style_rule_;
+  CharAttributes* attributes_;
+  bool attributes_valid_;
+  
   // Display integration
   ::DisplayManager* display_manager_;
+  int viewport_x_;
+  int viewport_y_;
+  bool auto_present_;
+  bool shared_display_;
+  uint32_t draw_count_;
   
   // Callbacks (legacy)
   RenderCallback render_callback_;
   ClearCallback clear_callback_;
   DrawCallback draw_callback_;
   BrightnessCallback brightness_callback_;
+  EventCallback on_complete_;
+  EventCallback on_wrap_;
+  
+  // Pre-rasterized window, one entry per pixel column (glyph columns plus
+  // spacing). Glyphs are rasterized once per window character, and only
+  // recolored when the styling changes, so a frame is a display-width copy
+  // out of the strip.
+  uint8_t* strip_mask_;        // Bit r set = row r lit
+  uint8_t* strip_brightness_;
+  int strip_columns_;
+  int strip_capacity_;
+  int strip_chars_;            // Leading window characters whose glyphs are rasterized
+  bool strip_valid_;
+  
+  // STATIC frames are retained per character cell: what each cell last
+  // showed, so only cells that changed are drawn (and their boards sent)
+  char* cell_text_;
+  uint8_t* cell_brightness_;
+  bool cells_valid_;
+  uint32_t cells_version_;     // DisplayManager buffer version after our last draw (unshared display)
   
   // Internal methods
   void updateSmoothScroll();
   void updateCharacterScroll();
   void updateStaticDisplay();
+  void updateLoopScroll();
+  bool completeScroll(bool can_wrap);
   void renderMessage();
-  uint8_t getCharacterBrightness(char c, int char_index);
-  bool isCharacterHighlighted(int char_index, uint8_t& highlight_brightness);
-  bool shouldCharacterBeVisible(int char_index, int char_pixel_pos) const;
+  void renderIfChanged();
+  void rebuildStrip();
+  void renderStaticCells(bool any_visible, uint32_t last_char);
+  void rasterizeChars(int first, int last);
+  void invalidateStrip() { strip_chars_ = 0; strip_valid_ = false; frame_valid_ = false; }
+  void invalidateAttributes() { attributes_valid_ = false; strip_valid_ = false; frame_valid_ = false; }
+  void invalidateWindow() { window_valid_ = false; invalidateAttributes(); invalidateStrip(); }
+  void beginLiveText();
+  int64_t advanceScroll(int64_t position, int64_t end, bool end_is_final, int scale = 1);
+  float getStepRate() const;
+  double easedDistance(double elapsed_ms, double rate, double total) const;
+  bool getVisibleRange(uint32_t& first_char, uint32_t& last_char) const;
+  void ensureWindow(uint32_t first_char, uint32_t last_char);
+  int readWindow(uint32_t position, char* out, int count);
+  int readLoop(uint32_t position, char* out, int count);
+  void trimPartialWord(uint32_t last_char);
+  bool loopSourcePosition(uint32_t position, uint32_t& source_position) const;
+  void skipDroppedText();
+  bool isMessageFinished() const;
+  void computeAttributes();
 };
 
 } // namespace RetroText
@@ -0,0 +1,36 @@
+#ifndef TCA9548A_MUX_H
+#define TCA9548A_MUX_H
+
+#include <stdint.h>
+#include "I2CBus.h"
+
+// TCA9548A-style 1-to-8 I2C multiplexer. Remembers the selected channel so
+// repeated selects of the same channel cost nothing on the bus.
+class Tca9548aMux {
+public:
+  static const uint8_t DEFAULT_ADDRESS = 0x70;
+  static const uint8_t NO_CHANNEL = 0xFF;
+  static const int CHANNEL_COUNT = 8;
+
+  Tca9548aMux(I2CBus* bus, uint8_t address = DEFAULT_ADDRESS);
+
+  // Route the downstream bus to `channel` (writes only if it changed)
+  bool select(uint8_t channel);
+  bool disableAll();
+
+  // Forget the selection, e.g. after a failed transfer or a mux reset
+  void invalidate() { channel_ = NO_CHANNEL; known_ = false; }
+
+  uint8_t getChannel() const { return channel_; }
+  bool isSelectionKnown() const { return known_; }
+  uint8_t getAddress() const { return address_; }
+  I2CBus* getBus() const { return bus_; }
+
+private:
+  I2CBus* bus_;
+  uint8_t address_;
+  uint8_t channel_;   // NO_CHANNEL when all channels are off or unknown
+  bool known_;
+};
+
+#endif // TCA9548A_MUX_H
@@ -0,0 +1,80 @@
+#ifndef TEXT_SOURCE_H
+#define TEXT_SOURCE_H
+
+#include <stdint.h>
+
+// Pull-based text for SignTextController. The controller reads only a small
+// window around the visible characters, so the text itself can live in
+// flash, in a file or in a bounded ring buffer instead of one heap String.
+// Positions are absolute character indexes from the start of the text.
+class TextSource {
+public:
+  virtual ~TextSource() {}
+
+  // Copy up to `count` characters starting at `position` into `out`.
+  // Returns the number copied - fewer only at the end of the text so far.
+  virtual int read(uint32_t position, char* out, int count) = 0;
+
+  // Characters available so far (the full length once isFinished())
+  virtual uint32_t length() const = 0;
+
+  // False while more text may still be appended (live feeds)
+  virtual bool isFinished() const { return true; }
+
+  // Oldest position still readable - sources that drop old text raise it
+  virtual uint32_t firstAvailable() const { return 0; }
+};
+
+// Text in memory that outlives the source: a string literal or PROGMEM
+// array (flash is mapped into the ESP32 address space) or a RAM buffer
+class MemoryTextSource : public TextSource {
+public:
+  MemoryTextSource() : text_(nullptr), length_(0) {}
+  MemoryTextSource(const char* text, uint32_t length) : text_(text), length_(length) {}
+  explicit MemoryTextSource(const char* text);
+
+  void set(const char* text, uint32_t length) { text_ = text; length_ = length; }
+
+  int read(uint32_t position, char* out, int count) override;
+  uint32_t length() const override { return length_; }
+
+private:
+  const char* text_;
+  uint32_t length_;
+};
+
+// Appendable live text in a fixed buffer. When full, the oldest characters
+// are dropped and firstAvailable() moves forward; memory use never grows.
+class RingTextSource : public TextSource {
+public:
+  explicit RingTextSource(int capacity);
+  ~RingTextSource();
+
+  // Append characters; returns how many older characters had to be dropped
+  int append(const char* text, int count);
+  int append(const char* text);
+  // Overwrite characters in place (a price or score that changed); only
+  // text still in the buffer can change. Returns the number written.
+  int replace(uint32_t position, const char* text, int count);
+  void finish() { finished_ = true; }   // No more text will arrive
+  void clear();
+
+  int read(uint32_t position, char* out, int count) override;
+  uint32_t length() const override { return end_; }
+  bool isFinished() const override { return finished_; }
+  uint32_t firstAvailable() const override { return end_ > (uint32_t)capacity_ ? end_ - capacity_ : 0; }
+
+  int getCapacity() const { return capacity_; }
+
+private:
+  char* buffer_;
+  int capacity_;
+  uint32_t end_;      // Absolute position one past the newest character
+  bool finished_;
+
+  // Non-copyable (owns the buffer)
+  RingTextSource(const RingTextSource&);
+  RingTextSource& operator=(const RingTextSource&);
+};
+
+#endif // TEXT_SOURCE_H
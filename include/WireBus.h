@@ -0,0 +1,25 @@
+#ifndef WIRE_BUS_H
+#define WIRE_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "I2CBus.h"
+
+// I2CBus on top of an Arduino TwoWire controller (Wire or Wire1)
+class WireBus : public I2CBus {
+public:
+  explicit WireBus(TwoWire* wire) : wire_(wire) {}
+
+  bool writeRegisters(uint8_t address, uint8_t start_register, const uint8_t* data, int length) override;
+  bool writeByte(uint8_t address, uint8_t value) override;
+  bool probe(uint8_t address) override;
+  int maxWriteLength() const override;
+
+  TwoWire* getWire() const { return wire_; }
+  uint8_t probeError(uint8_t address);  // Raw endTransmission() result for diagnostics
+
+private:
+  TwoWire* wire_;
+};
+
+#endif // WIRE_BUS_H
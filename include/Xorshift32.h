@@ -0,0 +1,21 @@
+#ifndef XORSHIFT32_H
+#define XORSHIFT32_H
+
+#include <stdint.h>
+
+// Marsaglia's xorshift32. Each effect keeps its own, so effects neither
+// share nor disturb rand().
+struct Xorshift32 {
+  uint32_t state;
+
+  explicit Xorshift32(uint32_t seed) : state(seed ? seed : 1) {}   // xorshift never leaves 0
+
+  uint32_t next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+};
+
+#endif // XORSHIFT32_H
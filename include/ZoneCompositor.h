@@ -0,0 +1,61 @@
+#ifndef ZONE_COMPOSITOR_H
+#define ZONE_COMPOSITOR_H
+
+#include <Arduino.h>
+#include "SignTextController.h"
+#include "ZoneGeometry.h"
+
+class DisplayManager;
+
+namespace RetroText {
+
+// Shares one DisplayManager between several controllers, e.g. a static
+// clock on the left board and a ticker across the other two. Each zone's
+// controller draws only into its own viewport; update() advances the zones
+// that are due and presents the shared frame once.
+class ZoneCompositor {
+public:
+  static const int MAX_ZONES = 4;
+
+  explicit ZoneCompositor(::DisplayManager* display_manager);
+
+  // Place a controller with its top-left pixel at (x, y). Its region is
+  // getViewportWidth() x 6 and must lie on the display without overlapping
+  // another zone. interval_ms is the minimum time between its updates
+  // (0 = every update()). Returns false when the zones are full or the
+  // region does not fit.
+  bool addZone(SignTextController* controller, int x, int y = 0, uint32_t interval_ms = 0);
+  void removeZone(SignTextController* controller);  // It presents on its own again
+  int getZoneCount() const { return zone_count_; }
+
+  // Call every loop. Zones driven by something else (a MessageQueue or a
+  // ClockDisplay) can be updated by it before this; the frame still goes
+  // out once here, and only if a zone changed it. When code other than the
+  // zones drew on the display since the last call, every zone is drawn
+  // again first.
+  void update();
+  void redraw();  // Draw every zone again on the next update()
+
+private:
+  struct Zone {
+    SignTextController* controller;
+    uint32_t interval_ms;
+    unsigned long last_update;
+  };
+
+  ::DisplayManager* display_manager_;
+  Zone zones_[MAX_ZONES];
+  ZoneRect regions_[MAX_ZONES];
+  int zone_count_;
+  
+  // Display buffer version and the zones' own share of it after the last
+  // update() - any other difference was drawn by someone else
+  uint32_t seen_version_;
+  uint32_t seen_zone_draws_;
+  
+  uint32_t zoneDrawCount() const;
+};
+
+} // namespace RetroText
+
+#endif // ZONE_COMPOSITOR_H
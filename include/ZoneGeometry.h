@@ -0,0 +1,26 @@
+#ifndef ZONE_GEOMETRY_H
+#define ZONE_GEOMETRY_H
+
+// A zone's pixel region on the display
+struct ZoneRect {
+  int x;
+  int y;
+  int width;
+  int height;
+};
+
+// Placement checks for ZoneCompositor
+class ZoneGeometry {
+public:
+  // True when the regions share at least one pixel
+  static bool overlaps(const ZoneRect& a, const ZoneRect& b);
+
+  // True when the whole region is on a display_width x display_height
+  // display - a zone hanging off an edge would be clipped without notice
+  static bool fits(const ZoneRect& zone, int display_width, int display_height);
+
+  // Index of the first of `count` zones that `zone` overlaps, -1 if none
+  static int findOverlap(const ZoneRect& zone, const ZoneRect* zones, int count);
+};
+
+#endif // ZONE_GEOMETRY_H
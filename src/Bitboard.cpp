@@ -0,0 +1,88 @@
+#include "Bitboard.h"
+#include <string.h>
+
+Bitboard::Bitboard()
+  : width_(0)
+  , height_(0)
+  , words_per_row_(0)
+  , tail_mask_(0)
+  , bits_(nullptr)
+{
+}
+
+Bitboard::~Bitboard() {
+  delete[] bits_;
+}
+
+bool Bitboard::allocate(int width, int height) {
+  if (width <= 0 || height <= 0) return false;
+
+  delete[] bits_;
+  width_ = width;
+  height_ = height;
+  words_per_row_ = (width + WORD_BITS - 1) / WORD_BITS;
+  int tail_bits = width % WORD_BITS;
+  tail_mask_ = tail_bits ? (1u << tail_bits) - 1 : 0xFFFFFFFFu;
+  bits_ = new uint32_t[words_per_row_ * height_];
+  clear();
+  return true;
+}
+
+void Bitboard::set(int x, int y, bool on) {
+  uint32_t bit = 1u << (x % WORD_BITS);
+  uint32_t& word = row(y)[x / WORD_BITS];
+  if (on) {
+    word |= bit;
+  } else {
+    word &= ~bit;
+  }
+}
+
+void Bitboard::clear() {
+  memset(bits_, 0, words_per_row_ * height_ * sizeof(uint32_t));
+}
+
+void Bitboard::copyFrom(const Bitboard& other) {
+  memcpy(bits_, other.bits_, words_per_row_ * height_ * sizeof(uint32_t));
+}
+
+bool Bitboard::equals(const Bitboard& other) const {
+  return memcmp(bits_, other.bits_, words_per_row_ * height_ * sizeof(uint32_t)) == 0;
+}
+
+int Bitboard::count() const {
+  int total = 0;
+  for (int i = 0; i < words_per_row_ * height_; i++) {
+    total += __builtin_popcount(bits_[i]);
+  }
+  return total;
+}
+
+void Bitboard::maskRow(uint32_t* bits) const {
+  bits[words_per_row_ - 1] &= tail_mask_;
+}
+
+void Bitboard::shiftFromWest(const uint32_t* bits, uint32_t* out) const {
+  // Moving every bit one place up; each word takes the top bit of the word
+  // before it, and bit 0 takes the last column
+  uint32_t carry = (bits[(width_ - 1) / WORD_BITS] >> ((width_ - 1) % WORD_BITS)) & 1;
+  for (int w = 0; w < words_per_row_; w++) {
+    uint32_t word = bits[w];
+    out[w] = (word << 1) | carry;
+    carry = word >> (WORD_BITS - 1);
+  }
+  maskRow(out);
+}
+
+void Bitboard::shiftFromEast(const uint32_t* bits, uint32_t* out) const {
+  // Moving every bit one place down; the last column takes bit 0
+  uint32_t carry = bits[0] & 1;
+  int last = words_per_row_ - 1;
+  int top_bit = (width_ - 1) % WORD_BITS;
+  for (int w = last; w >= 0; w--) {
+    uint32_t word = bits[w];
+    uint32_t incoming = w == last ? carry << top_bit : carry << (WORD_BITS - 1);
+    out[w] = (word >> 1) | incoming;
+    carry = word & 1;
+  }
+}
@@ -0,0 +1,257 @@
+#include "BoardChain.h"
+#include <string.h>
+
+// IS31FL3737 register access (datasheet: command register + write lock)
+static const uint8_t REG_COMMAND = 0xFD;
+static const uint8_t REG_WRITE_LOCK = 0xFE;
+static const uint8_t WRITE_LOCK_MAGIC = 0xC5;
+static const uint8_t PAGE_LED_CONTROL = 0x00;
+static const uint8_t PAGE_PWM = 0x01;
+static const uint8_t PAGE_FUNCTION = 0x03;
+static const uint8_t PAGE_UNKNOWN = 0xFF;
+static const int LED_CONTROL_SIZE = 0x18;          // On/off bits, 2 bytes per SW row
+static const uint8_t REG_CONFIGURATION = 0x00;     // Function page
+static const uint8_t REG_GLOBAL_CURRENT = 0x01;    // Function page
+static const uint8_t CONFIG_NORMAL_OPERATION = 0x01;
+
+// Unchanged registers worth re-sending to avoid a new transaction: each
+// transaction costs 2 bytes plus start/stop and driver latency
+static const int BURST_MERGE_GAP = 6;
+
+// Bytes for a page select (unlock + command) and a mux channel select
+static const int PAGE_SELECT_BYTES = 2 * (BurstPlanner::TRANSACTION_OVERHEAD + 1);
+static const int MUX_SELECT_BYTES = 2;
+
+BoardChain::BoardChain()
+  : boards_(nullptr)
+  , num_boards_(0)
+  , sent_pwm_(nullptr)
+  , next_pwm_(nullptr)
+{
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    buses_[bus] = nullptr;
+    muxes_[bus] = nullptr;
+  }
+  resetStats();
+}
+
+BoardChain::~BoardChain() {
+  delete[] boards_;
+  delete[] sent_pwm_;
+  delete[] next_pwm_;
+}
+
+void BoardChain::attachBus(int bus, I2CBus* i2c, Tca9548aMux* mux) {
+  if (bus < 0 || bus >= MAX_BUSES) return;
+  buses_[bus] = i2c;
+  muxes_[bus] = mux;
+  for (int i = 0; i < num_boards_; i++) {
+    if (boards_[i].bus == bus) invalidate(i);
+  }
+}
+
+void BoardChain::resize(int num_boards) {
+  delete[] boards_;
+  delete[] sent_pwm_;
+  delete[] next_pwm_;
+
+  num_boards_ = num_boards;
+  boards_ = new Board[num_boards];
+  sent_pwm_ = new uint8_t[num_boards * PanelLayout::PWM_PAGE_SIZE]();
+  next_pwm_ = new uint8_t[num_boards * PanelLayout::PWM_PAGE_SIZE]();
+  for (int i = 0; i < num_boards; i++) {
+    boards_[i].bus = 0;
+    boards_[i].mux_channel = NO_MUX_CHANNEL;
+    boards_[i].address = 0;
+    boards_[i].online = false;
+    invalidate(i);
+  }
+}
+
+void BoardChain::setBoard(int board, uint8_t bus, uint8_t mux_channel, uint8_t address) {
+  if (board < 0 || board >= num_boards_ || bus >= MAX_BUSES) return;
+  boards_[board].bus = bus;
+  boards_[board].mux_channel = mux_channel;
+  boards_[board].address = address;
+  boards_[board].online = false;
+  invalidate(board);
+}
+
+bool BoardChain::isBusUsed(int bus) const {
+  for (int i = 0; i < num_boards_; i++) {
+    if (boards_[i].bus == bus) return true;
+  }
+  return false;
+}
+
+I2CBus* BoardChain::getBus(int bus, Tca9548aMux** mux) const {
+  if (mux) *mux = muxes_[bus];
+  return buses_[bus];
+}
+
+bool BoardChain::probe(int board) {
+  if (!route(board, nullptr)) return false;
+  return buses_[boards_[board].bus]->probe(boards_[board].address);
+}
+
+bool BoardChain::initializeBoard(int board, uint8_t global_current) {
+  // Enable every LED, set the current limit, then leave software shutdown
+  uint8_t led_on[LED_CONTROL_SIZE];
+  memset(led_on, 0xFF, sizeof(led_on));
+  uint8_t configuration = CONFIG_NORMAL_OPERATION;
+
+  boards_[board].current_page = PAGE_UNKNOWN;
+  bool ok = selectPage(board, PAGE_LED_CONTROL, nullptr) &&
+            writeRegisters(board, 0x00, led_on, LED_CONTROL_SIZE) &&
+            selectPage(board, PAGE_FUNCTION, nullptr) &&
+            writeRegisters(board, REG_GLOBAL_CURRENT, &global_current, 1) &&
+            writeRegisters(board, REG_CONFIGURATION, &configuration, 1);
+
+  boards_[board].online = ok;
+  invalidate(board);  // PWM page content is unknown until the first flush
+  return ok;
+}
+
+bool BoardChain::setGlobalCurrent(int board, uint8_t current) {
+  return selectPage(board, PAGE_FUNCTION, nullptr) &&
+         writeRegisters(board, REG_GLOBAL_CURRENT, &current, 1);
+}
+
+bool BoardChain::writePwmRegister(int board, uint8_t pwm_register, uint8_t value) {
+  bool ok = selectPage(board, PAGE_PWM, nullptr) &&
+            writeRegisters(board, pwm_register, &value, 1);
+  boards_[board].sent_valid = false;
+  return ok;
+}
+
+void BoardChain::invalidate(int board) {
+  boards_[board].current_page = PAGE_UNKNOWN;
+  boards_[board].sent_valid = false;
+}
+
+void BoardChain::flushBus(int bus, const uint8_t* frame, const PhysicalPixel* map, int pixel_count,
+                          bool* dirty, uint8_t master_brightness) {
+  // Render this bus's dirty boards into their next PWM register images
+  for (int i = 0; i < pixel_count; i++) {
+    uint8_t board = map[i].board;
+    if (board < num_boards_ && dirty[board] && boards_[board].bus == bus) {
+      uint8_t value = frame[i];
+      if (master_brightness != 255) {
+        value = (value * (master_brightness + 1)) >> 8;
+      }
+      next_pwm_[board * PanelLayout::PWM_PAGE_SIZE + map[i].pwm_register] = value;
+    }
+  }
+
+  FlushStats& stats = stats_[bus];
+  stats.bytes_last_frame = 0;
+  stats.bursts_last_frame = 0;
+  stats.boards_last_frame = 0;
+  stats.selects_last_frame = 0;
+
+  // Channel visiting order: trunk boards (no select), the channel the mux is
+  // already on, then the remaining channels in order
+  uint8_t order[Tca9548aMux::CHANNEL_COUNT + 2];
+  int passes = 0;
+  order[passes++] = NO_MUX_CHANNEL;
+  Tca9548aMux* mux = muxes_[bus];
+  if (mux) {
+    uint8_t current = mux->isSelectionKnown() ? mux->getChannel() : NO_MUX_CHANNEL;
+    if (current != NO_MUX_CHANNEL) order[passes++] = current;
+    for (int channel = 0; channel < Tca9548aMux::CHANNEL_COUNT; channel++) {
+      if (channel != current) order[passes++] = channel;
+    }
+  }
+
+  for (int pass = 0; pass < passes; pass++) {
+    for (int i = 0; i < num_boards_; i++) {
+      if (!dirty[i] || boards_[i].bus != bus) continue;
+      if (mux && boards_[i].mux_channel != order[pass]) continue;
+
+      if (boards_[i].online) {
+        flushBoard(i);
+      }
+      dirty[i] = false;
+    }
+  }
+
+  stats.bytes_total += stats.bytes_last_frame;
+  stats.frames_total++;
+}
+
+void BoardChain::resetStats() {
+  memset(stats_, 0, sizeof(stats_));
+}
+
+bool BoardChain::route(int board, FlushStats* stats) {
+  Tca9548aMux* mux = muxes_[boards_[board].bus];
+  uint8_t channel = boards_[board].mux_channel;
+  if (!mux || channel == NO_MUX_CHANNEL) return true;
+  if (mux->isSelectionKnown() && mux->getChannel() == channel) return true;
+
+  if (!mux->select(channel)) return false;
+  if (stats) {
+    stats->bytes_last_frame += MUX_SELECT_BYTES;
+    stats->selects_last_frame++;
+  }
+  return true;
+}
+
+bool BoardChain::selectPage(int board, uint8_t page, FlushStats* stats) {
+  if (boards_[board].current_page == page) return true;
+
+  uint8_t unlock = WRITE_LOCK_MAGIC;
+  if (!writeRegisters(board, REG_WRITE_LOCK, &unlock, 1) ||
+      !writeRegisters(board, REG_COMMAND, &page, 1)) {
+    boards_[board].current_page = PAGE_UNKNOWN;
+    return false;
+  }
+  boards_[board].current_page = page;
+  if (stats) {
+    stats->bytes_last_frame += PAGE_SELECT_BYTES;
+    stats->bursts_last_frame += 2;
+  }
+  return true;
+}
+
+bool BoardChain::writeRegisters(int board, uint8_t start_register, const uint8_t* data, int length) {
+  const Board& b = boards_[board];
+  I2CBus* i2c = buses_[b.bus];
+  if (!i2c || !route(board, nullptr)) return false;
+
+  if (!i2c->writeRegisters(b.address, start_register, data, length)) {
+    if (muxes_[b.bus]) muxes_[b.bus]->invalidate();
+    return false;
+  }
+  return true;
+}
+
+void BoardChain::flushBoard(int board) {
+  Board& b = boards_[board];
+  uint8_t* sent = &sent_pwm_[board * PanelLayout::PWM_PAGE_SIZE];
+  const uint8_t* next = &next_pwm_[board * PanelLayout::PWM_PAGE_SIZE];
+
+  RegisterBurst bursts[PanelLayout::PWM_PAGE_SIZE / 2 + 1];
+  int burst_count = BurstPlanner::plan(b.sent_valid ? sent : nullptr, next,
+                                       PanelLayout::PWM_PAGE_SIZE, BURST_MERGE_GAP,
+                                       buses_[b.bus]->maxWriteLength(), bursts);
+  if (burst_count == 0) return;
+
+  FlushStats& stats = stats_[b.bus];
+  bool ok = route(board, &stats) && selectPage(board, PAGE_PWM, &stats);
+  for (int i = 0; ok && i < burst_count; i++) {
+    ok = writeRegisters(board, bursts[i].start, &next[bursts[i].start], bursts[i].length);
+  }
+
+  if (!ok) {
+    // Partial write - resend the full page next time
+    invalidate(board);
+    return;
+  }
+
+  memcpy(sent, next, PanelLayout::PWM_PAGE_SIZE);
+  b.sent_valid = true;
+  stats.bytes_last_frame += BurstPlanner::wireBytes(bursts, burst_count);
+  stats.bursts_last_frame += burst_count;
+  stats.boards_last_frame++;
+}
@@ -0,0 +1,49 @@
+#include "BurstPlanner.h"
+
+int BurstPlanner::plan(const uint8_t* sent, const uint8_t* next, int count,
+                       int merge_gap, int max_burst_length, RegisterBurst* out) {
+  int bursts = 0;
+  int i = 0;
+
+  while (i < count) {
+    if (sent && sent[i] == next[i]) {
+      i++;
+      continue;
+    }
+
+    // Grow a burst from the first changed register, bridging short gaps
+    int start = i;
+    int last_changed = i;
+    int j = i + 1;
+    while (j < count && j - start < max_burst_length) {
+      if (!sent || sent[j] != next[j]) {
+        last_changed = j++;
+        continue;
+      }
+
+      int gap_end = j;
+      while (gap_end < count && sent[gap_end] == next[gap_end]) {
+        gap_end++;
+      }
+      if (gap_end >= count || gap_end - j > merge_gap || gap_end - start >= max_burst_length) {
+        break;
+      }
+      j = gap_end;
+    }
+
+    out[bursts].start = start;
+    out[bursts].length = last_changed - start + 1;
+    bursts++;
+    i = last_changed + 1;
+  }
+
+  return bursts;
+}
+
+int BurstPlanner::wireBytes(const RegisterBurst* bursts, int count) {
+  int bytes = 0;
+  for (int i = 0; i < count; i++) {
+    bytes += TRANSACTION_OVERHEAD + bursts[i].length;
+  }
+  return bytes;
+}
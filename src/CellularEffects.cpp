@@ -0,0 +1,381 @@
+#include "CellularEffects.h"
+#include <stdio.h>
+#include <string.h>
+
+static const int MAX_STEPS_PER_UPDATE = 4;   // Catch up at most this far
+
+// ---------------------------------------------------------------------------
+// BitboardEffect
+
+BitboardEffect::BitboardEffect(uint8_t steps_per_second, uint32_t seed)
+  : width_(0)
+  , height_(0)
+  , scratch_(nullptr)
+  , steps_per_second_(steps_per_second)
+  , rng_(seed)
+  , pending_ms_(0)
+{
+  memset(levels_, 0, sizeof(levels_));
+  for (int i = 0; i < 3; i++) {
+    planes_[i] = &storage_[i];
+  }
+}
+
+BitboardEffect::~BitboardEffect() {
+  delete[] scratch_;
+}
+
+bool BitboardEffect::init(int width, int height) {
+  width_ = width;
+  height_ = height;
+  for (int i = 0; i < 3; i++) {
+    if (!storage_[i].allocate(width, height)) return false;
+  }
+  delete[] scratch_;
+  scratch_ = new uint32_t[2 * storage_[0].getWordsPerRow()];
+  if (!allocateExtra()) return false;
+
+  seed();
+  return true;
+}
+
+void BitboardEffect::reset() {
+  for (int i = 0; i < 3; i++) {
+    planes_[i]->clear();
+  }
+  pending_ms_ = 0;
+  seed();
+}
+
+void BitboardEffect::update(uint32_t elapsed_ms) {
+  uint32_t interval = 1000 / steps_per_second_;
+  pending_ms_ += elapsed_ms;
+  int steps = 0;
+  while (pending_ms_ >= interval && steps < MAX_STEPS_PER_UPDATE) {
+    step();
+    pending_ms_ -= interval;
+    steps++;
+  }
+  if (pending_ms_ >= interval) pending_ms_ = 0;  // Too far behind - drop it
+}
+
+void BitboardEffect::render(uint8_t* frame) {
+  for (int y = 0; y < height_; y++) {
+    const uint32_t* bits0 = planes_[0]->row(y);
+    const uint32_t* bits1 = planes_[1]->row(y);
+    const uint32_t* bits2 = planes_[2]->row(y);
+    uint8_t* out = frame + y * width_;
+
+    for (int x = 0; x < width_; x += Bitboard::WORD_BITS) {
+      int w = x / Bitboard::WORD_BITS;
+      uint32_t b0 = bits0[w];
+      uint32_t b1 = bits1[w];
+      uint32_t b2 = bits2[w];
+      int end = width_ - x < Bitboard::WORD_BITS ? width_ - x : Bitboard::WORD_BITS;
+      for (int i = 0; i < end; i++) {
+        out[x + i] = levels_[(b0 & 1) | ((b1 & 1) << 1) | ((b2 & 1) << 2)];
+        b0 >>= 1;
+        b1 >>= 1;
+        b2 >>= 1;
+      }
+    }
+  }
+}
+
+void BitboardEffect::rotateHistory() {
+  Bitboard* oldest = planes_[2];
+  planes_[2] = planes_[1];
+  planes_[1] = planes_[0];
+  planes_[0] = oldest;
+}
+
+uint32_t BitboardEffect::randomBits(int sparsity) {
+  uint32_t bits = 0xFFFFFFFFu;
+  for (int i = 0; i < sparsity; i++) {
+    bits &= random();
+  }
+  return bits;
+}
+
+// ---------------------------------------------------------------------------
+// LifeEffect
+
+static const int LIFE_RESEED_STEPS = 24;   // Stagnant steps before reseeding
+
+LifeEffect::LifeEffect()
+  : BitboardEffect(8, 0x11FE)
+  , stagnant_steps_(0)
+{
+  // Index bits: alive now, one step ago, two steps ago
+  levels_[1] = 110;  // Born
+  levels_[5] = 110;  // Born again
+  levels_[3] = 70;   // Survived
+  levels_[7] = 50;   // Settled
+  levels_[2] = 15;   // Just died
+  levels_[6] = 15;
+  levels_[4] = 5;    // Died a step earlier
+}
+
+bool LifeEffect::allocateExtra() {
+  return west_.allocate(width_, height_) && east_.allocate(width_, height_);
+}
+
+void LifeEffect::seed() {
+  Bitboard& cells = plane(0);
+  for (int y = 0; y < height_; y++) {
+    uint32_t* row = cells.row(y);
+    for (int w = 0; w < cells.getWordsPerRow(); w++) {
+      row[w] = randomBits(2) | randomBits(3);   // About a third alive
+    }
+    cells.maskRow(row);
+  }
+  stagnant_steps_ = 0;
+}
+
+void LifeEffect::step() {
+  rotateHistory();
+  const Bitboard& last = plane(1);
+  Bitboard& next = plane(0);
+  int words = last.getWordsPerRow();
+
+  for (int y = 0; y < height_; y++) {
+    last.shiftFromWest(last.row(y), west_.row(y));
+    last.shiftFromEast(last.row(y), east_.row(y));
+  }
+
+  for (int y = 0; y < height_; y++) {
+    int up = (y + height_ - 1) % height_;
+    int down = (y + 1) % height_;
+    for (int w = 0; w < words; w++) {
+      uint32_t neighbours[8] = {
+        west_.row(up)[w], last.row(up)[w], east_.row(up)[w],
+        west_.row(y)[w], east_.row(y)[w],
+        west_.row(down)[w], last.row(down)[w], east_.row(down)[w]
+      };
+
+      // Bit-sliced count of the 8 neighbours of 32 cells at once: ones and
+      // twos are the low bits, four_plus saturates
+      uint32_t ones = 0, twos = 0, four_plus = 0;
+      for (int n = 0; n < 8; n++) {
+        uint32_t carry = ones & neighbours[n];
+        ones ^= neighbours[n];
+        four_plus |= twos & carry;
+        twos ^= carry;
+      }
+
+      // Alive with 3 neighbours, or alive already with 2
+      next.row(y)[w] = twos & ~four_plus & (ones | last.row(y)[w]);
+    }
+  }
+
+  // Dead, still or blinking (same as two steps ago) for a while: start over
+  if (next.equals(plane(2)) || next.count() == 0) {
+    if (++stagnant_steps_ >= LIFE_RESEED_STEPS) seed();
+  } else {
+    stagnant_steps_ = 0;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// ElementaryEffect
+
+static const int ELEMENTARY_RESEED_STEPS = 12;
+
+ElementaryEffect::ElementaryEffect(uint8_t rule)
+  : BitboardEffect(6, 0xE1E0 + rule)
+  , rule_(rule)
+  , stagnant_steps_(0)
+{
+  snprintf(name_, sizeof(name_), "Rule %d", rule);
+  for (int i = 1; i < 8; i += 2) {
+    levels_[i] = 60;   // Only the current state shows; history scrolled away
+  }
+}
+
+void ElementaryEffect::seed() {
+  Bitboard& cells = plane(0);
+  uint32_t* bottom = cells.row(height_ - 1);
+  for (int w = 0; w < cells.getWordsPerRow(); w++) {
+    bottom[w] = random();
+  }
+  cells.maskRow(bottom);
+  stagnant_steps_ = 0;
+}
+
+void ElementaryEffect::step() {
+  rotateHistory();
+  const Bitboard& last = plane(1);
+  Bitboard& next = plane(0);
+  int words = last.getWordsPerRow();
+
+  for (int y = 0; y + 1 < height_; y++) {
+    memcpy(next.row(y), last.row(y + 1), words * sizeof(uint32_t));
+  }
+
+  // Every cell looks at (left, centre, right); rule bit p says whether
+  // pattern p = 4*left + 2*centre + right is alive in the next row
+  const uint32_t* centre = last.row(height_ - 1);
+  uint32_t* left = scratch_;
+  uint32_t* right = scratch_ + words;
+  last.shiftFromWest(centre, left);
+  last.shiftFromEast(centre, right);
+
+  uint32_t* bottom = next.row(height_ - 1);
+  bool changed = false;
+  bool any = false;
+  for (int w = 0; w < words; w++) {
+    uint32_t out = 0;
+    for (int p = 0; p < 8; p++) {
+      if (!((rule_ >> p) & 1)) continue;
+      out |= ((p & 4) ? left[w] : ~left[w]) &
+             ((p & 2) ? centre[w] : ~centre[w]) &
+             ((p & 1) ? right[w] : ~right[w]);
+    }
+    bottom[w] = out;
+  }
+  next.maskRow(bottom);
+  for (int w = 0; w < words; w++) {
+    changed |= bottom[w] != centre[w];
+    any |= bottom[w] != 0;
+  }
+
+  if (!changed || !any) {
+    if (++stagnant_steps_ >= ELEMENTARY_RESEED_STEPS) seed();
+  } else {
+    stagnant_steps_ = 0;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// RainEffect
+
+RainEffect::RainEffect()
+  : BitboardEffect(12, 0x4A1)
+{
+  // Index bits: drop here now, one step ago, two steps ago
+  levels_[1] = 90;
+  levels_[2] = 30;
+  levels_[3] = 90;
+  levels_[4] = 10;
+  levels_[5] = 90;
+  levels_[6] = 30;
+  levels_[7] = 90;
+}
+
+void RainEffect::seed() {
+  // Starts from a dry display; drops arrive from the top
+}
+
+void RainEffect::step() {
+  rotateHistory();
+  const Bitboard& last = plane(1);
+  Bitboard& next = plane(0);
+  int words = last.getWordsPerRow();
+
+  for (int y = height_ - 1; y > 0; y--) {
+    memcpy(next.row(y), last.row(y - 1), words * sizeof(uint32_t));
+  }
+  uint32_t* top = next.row(0);
+  for (int w = 0; w < words; w++) {
+    top[w] = randomBits(4);   // One column in 16 starts a drop
+  }
+  next.maskRow(top);
+}
+
+// ---------------------------------------------------------------------------
+// SparkleEffect
+
+SparkleEffect::SparkleEffect()
+  : BitboardEffect(10, 0x5BA4)
+{
+  // Index bits: lit now, one step ago, two steps ago
+  levels_[1] = 120;
+  levels_[3] = 120;
+  levels_[5] = 120;
+  levels_[7] = 120;
+  levels_[2] = 40;
+  levels_[6] = 40;
+  levels_[4] = 12;
+}
+
+void SparkleEffect::seed() {
+  // Nothing lit until the first step
+}
+
+void SparkleEffect::step() {
+  rotateHistory();
+  Bitboard& next = plane(0);
+  for (int y = 0; y < height_; y++) {
+    uint32_t* row = next.row(y);
+    for (int w = 0; w < next.getWordsPerRow(); w++) {
+      row[w] = randomBits(5);   // One pixel in 32
+    }
+    next.maskRow(row);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// NoiseEffect
+
+NoiseEffect::NoiseEffect()
+  : BitboardEffect(15, 0x7015E)
+  , column_(nullptr)
+  , smoothed_(nullptr)
+{
+  // Index is the pixel's 3-bit level; roughly perceptual steps
+  static const uint8_t LEVELS[8] = {0, 2, 5, 10, 18, 30, 46, 66};
+  memcpy(levels_, LEVELS, sizeof(levels_));
+}
+
+NoiseEffect::~NoiseEffect() {
+  delete[] column_;
+  delete[] smoothed_;
+}
+
+bool NoiseEffect::allocateExtra() {
+  delete[] column_;
+  delete[] smoothed_;
+  column_ = new uint8_t[height_];
+  smoothed_ = new uint8_t[height_];
+  return true;
+}
+
+void NoiseEffect::seed() {
+  for (int y = 0; y < height_; y++) {
+    column_[y] = random() & 7;
+  }
+  // Fill the display by scrolling in a full width of columns
+  for (int x = 0; x < width_; x++) {
+    step();
+  }
+}
+
+void NoiseEffect::step() {
+  // Random walk per row, then blend each row with its neighbours so the
+  // clouds are smooth vertically as well
+  for (int y = 0; y < height_; y++) {
+    int level = column_[y] + (int)(random() % 3) - 1;
+    column_[y] = level < 0 ? 0 : (level > 7 ? 7 : level);
+  }
+  for (int y = 0; y < height_; y++) {
+    int above = column_[y > 0 ? y - 1 : y];
+    int below = column_[y + 1 < height_ ? y + 1 : y];
+    smoothed_[y] = (above + 2 * column_[y] + below + 2) / 4;
+  }
+
+  // Scroll every plane one column left, then write the new column's bits
+  int last_word = (width_ - 1) / Bitboard::WORD_BITS;
+  uint32_t last_bit = 1u << ((width_ - 1) % Bitboard::WORD_BITS);
+  for (int p = 0; p < 3; p++) {
+    Bitboard& bits = plane(p);
+    for (int y = 0; y < height_; y++) {
+      uint32_t* row = bits.row(y);
+      bits.shiftFromEast(row, row);
+      if ((smoothed_[y] >> p) & 1) {
+        row[last_word] |= last_bit;
+      } else {
+        row[last_word] &= ~last_bit;
+      }
+    }
+  }
+}
@@ -1,29 +1,21 @@
 #include "ClockDisplay.h"
 
-// Static instance pointer for callback
-ClockDisplay* ClockDisplay::instance_ = nullptr;
-
 ClockDisplay::ClockDisplay(DisplayManager* display_manager, WifiTimeLib* wifi_time_lib)
   : display_manager_(display_manager)
   , wifi_time_lib_(wifi_time_lib)
   , clock_controller_(nullptr)
   , update_interval_(1000)  // Update every second
   , last_update_time_(0)
-  , time_brightness_(150)   // Bright for time
-  , date_brightness_(20)    // Dim for date
+  , time_style_(8, 150, 20)  // "12:43:25" at the end bright, date dim
   , time_valid_(false)
   , sync_failure_time_(0)
 {
-  instance_ = this;  // Set static instance for callback
 }
 
 ClockDisplay::~ClockDisplay() {
   if (clock_controller_) {
     delete clock_controller_;
   }
-  if (instance_ == this) {
-    instance_ = nullptr;
-  }
 }
 
 bool ClockDisplay::initialize() {
@@ -109,8 +101,10 @@ void ClockDisplay::setFont(RetroText::Font font) {
 }
 
 void ClockDisplay::setBrightness(uint8_t time_brightness, uint8_t date_brightness) {
-  time_brightness_ = time_brightness;
-  date_brightness_ = date_brightness;
+  time_style_.setBrightness(time_brightness, date_brightness);
+  if (clock_controller_) {
+    clock_controller_->setStyleRule(&time_style_);  // Restyle the current line
+  }
 }
 
 bool ClockDisplay::isTimeValid() const {
@@ -160,36 +154,6 @@ void ClockDisplay::setupController() {
   clock_controller_->setScrollSpeed(1000);  // Not used for static display
   clock_controller_->setBrightness(RetroText::NORMAL);
   
-  // Set up callbacks to use DisplayManager
-  clock_controller_->setRenderCallback([this](uint8_t character, int pixel_offset, uint8_t brightness, bool use_alt_font) {
-    // Get character pattern
-    uint8_t pattern[6];
-    for (int row = 0; row < 6; row++) {
-      pattern[row] = display_manager_->getCharacterPattern(character, row, use_alt_font);
-    }
-    
-    // Draw character using DisplayManager
-    display_manager_->drawCharacter(pattern, pixel_offset, brightness);
-  });
-  
-  clock_controller_->setClearCallback([this]() {
-    display_manager_->clearBuffer();
-  });
-  
-  clock_controller_->setDrawCallback([this]() {
-    display_manager_->updateDisplay();
-  });
-  
-  clock_controller_->setBrightnessCallback(clockBrightnessCallback);
-}
-
-uint8_t ClockDisplay::clockBrightnessCallback(char c, String text, int char_pos, bool is_time_display) {
-  if (!instance_) return 70; // Default brightness
-  
-  // Time display: bright for time (last 8 characters), dim for date
-  int time_start_pos = text.length() - 8;  // Time starts at position for "12:43:25"
-  if (char_pos >= time_start_pos) {
-    return instance_->time_brightness_;  // Time portion is bright
-  }
-  return instance_->date_brightness_;  // Date portion is dim
+  clock_controller_->setDisplayManager(display_manager_);
+  clock_controller_->setStyleRule(&time_style_);
 }
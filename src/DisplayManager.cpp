@@ -3,67 +3,191 @@
 #include <fonts/retro_font4x6.h>
 #include <fonts/modern_font4x6.h>
 
-DisplayManager::DisplayManager(int num_boards, int board_width, int board_height)
+static const uint8_t DEFAULT_GLOBAL_CURRENT = 50;
+
+// Boards per bus or mux channel - one per ADDR jumper setting
+static const int BOARDS_PER_SEGMENT = 4;
+
+// ADDR jumper settings in the order boards are numbered on each bus
+static const ADDR DEFAULT_ADDR_ORDER[4] = { ADDR::GND, ADDR::VCC, ADDR::SDA, ADDR::SCL };
+
+// Rows must tile the boards evenly; otherwise fall back to one row rather
+// than silently leaving the boards of a partial row off the display
+static int tiledRows(int num_boards, int board_rows) {
+  if (board_rows <= 1) return 1;
+  if (num_boards % board_rows != 0) {
+    Serial.printf("WARNING: %d boards do not fill %d rows evenly - using one row\n", num_boards, board_rows);
+    return 1;
+  }
+  return board_rows;
+}
+
+DisplayManager::DisplayManager(int num_boards, int board_width, int board_height, int board_rows)
   : num_boards_(num_boards)
+  , board_rows_(tiledRows(num_boards, board_rows))
   , board_width_(board_width)
   , board_height_(board_height)
-  , total_width_(board_width * num_boards)
-  , total_height_(board_height)
+  , total_width_(board_width * (num_boards / board_rows_))
+  , total_height_(board_height * board_rows_)
   , character_width_(4)
   , max_characters_(total_width_ / character_width_)
-  , drivers_{nullptr, nullptr, nullptr, nullptr}
+  , boards_(nullptr)
+  , wire_buses_{WireBus(&Wire), WireBus(&Wire1)}
+  , muxes_{nullptr, nullptr}
+  , bus_sda_{-1, -1}
+  , bus_scl_{-1, -1}
+  , bus_frequency_{800000, 800000}
+  , frame_buffer_(nullptr)
+  , front_buffer_(nullptr)
+  , board_dirty_(nullptr)
+  , front_dirty_(nullptr)
+  , blend_scratch_(nullptr)
+  , buffer_version_(0)
+  , layer_buffers_{nullptr, nullptr, nullptr}
+  , layer_blend_{BLEND_REPLACE, BLEND_REPLACE, BLEND_REPLACE}
+  , layer_alpha_{255, 255, 255}
+  , layer_enabled_{false, true, false}
+  , compose_buffer_(nullptr)
+  , draw_layer_(LAYER_CONTENT)
+  , layers_active_(false)
+  , layers_changed_(false)
+  , flushes_pending_(0)
+  , flush_done_(nullptr)
+  , async_flush_(false)
+  , master_brightness_(255)
 {
+  frame_buffer_ = new uint8_t[total_width_ * total_height_]();
+  front_buffer_ = new uint8_t[total_width_ * total_height_]();
+  blend_scratch_ = new uint8_t[total_width_ * 3];
+  
+  boards_ = new BoardConfig[num_boards_];
+  board_dirty_ = new bool[num_boards_]();
+  front_dirty_ = new bool[num_boards_]();
+  chain_.resize(num_boards_);
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    chain_.attachBus(bus, &wire_buses_[bus]);
+    flush_tasks_[bus].owner = this;
+    flush_tasks_[bus].bus = bus;
+    flush_tasks_[bus].handle = nullptr;
+  }
+  assignDefaultBoards();
+  
+  BoardPlacement* placements = new BoardPlacement[num_boards_];
+  int count = PanelLayout::defaultGrid(num_boards_ / board_rows_, board_rows_,
+                                       board_width_, board_height_, placements);
+  layout_.build(placements, count, num_boards_, total_width_, total_height_, board_width_, board_height_);
+  delete[] placements;
+  markAllBoardsDirty();
 }
 
 DisplayManager::~DisplayManager() {
-  for (int i = 0; i < 4; i++) {
-    if (drivers_[i]) {
-      delete drivers_[i];
+  waitForFlush();
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    if (flush_tasks_[bus].handle) {
+      vTaskDelete(flush_tasks_[bus].handle);
     }
   }
+  if (flush_done_) {
+    vSemaphoreDelete(flush_done_);
+  }
+  delete[] frame_buffer_;
+  delete[] front_buffer_;
+  delete[] blend_scratch_;
+  for (int layer = 0; layer < LAYER_COUNT; layer++) {
+    delete[] layer_buffers_[layer];
+  }
+  delete[] compose_buffer_;
+  delete[] boards_;
+  delete[] board_dirty_;
+  delete[] front_dirty_;
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    delete muxes_[bus];
+  }
+}
+
+void DisplayManager::configureBus(int bus, int sda_pin, int scl_pin, uint32_t frequency) {
+  if (bus < 0 || bus >= MAX_BUSES) return;
+  bus_sda_[bus] = sda_pin;
+  bus_scl_[bus] = scl_pin;
+  bus_frequency_[bus] = frequency;
+}
+
+void DisplayManager::configureMux(int bus, uint8_t mux_address) {
+  if (bus < 0 || bus >= MAX_BUSES) return;
+  delete muxes_[bus];
+  muxes_[bus] = new Tca9548aMux(&wire_buses_[bus], mux_address);
+  chain_.attachBus(bus, &wire_buses_[bus], muxes_[bus]);
+  assignDefaultBoards();
+}
+
+bool DisplayManager::setBoardConfig(int board_index, uint8_t bus, ADDR addr, uint8_t mux_channel) {
+  if (board_index < 0 || board_index >= num_boards_ || bus >= MAX_BUSES) return false;
+  if (mux_channel != NO_MUX_CHANNEL && mux_channel >= Tca9548aMux::CHANNEL_COUNT) return false;
+  waitForFlush();  // The flush tasks read the board's bus and address
+  boards_[board_index].bus = bus;
+  boards_[board_index].mux_channel = mux_channel;
+  boards_[board_index].addr = addr;
+  chain_.setBoard(board_index, bus, mux_channel, getI2CAddressFromADDR(addr));
+  invalidateBoard(board_index);
+  return true;
 }
 
 bool DisplayManager::initialize() {
   Serial.println("Initializing DisplayManager...");
   
+  int first = 0, second = 0;
+  if (findSharedAddress(first, second)) {
+    Serial.printf("ERROR: Boards %d and %d have the same bus, mux channel and ADDR - "
+                  "use setBoardConfig() or configureMux() to tell them apart\n", first, second);
+    return false;
+  }
+  
   // Initialize I2C
   Serial.println("Setting up I2C...");
-  Wire.begin();
-  Wire.setClock(800000); // 800 kHz I2C
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    if (!chain_.isBusUsed(bus)) continue;
+    
+    TwoWire* wire = wire_buses_[bus].getWire();
+    if (bus_sda_[bus] >= 0 && bus_scl_[bus] >= 0) {
+      wire->begin(bus_sda_[bus], bus_scl_[bus], bus_frequency_[bus]);
+    } else if (bus == 0) {
+      wire->begin();  // Board default pins
+    } else {
+      Serial.printf("WARNING: I2C bus %d has boards but no pins - call configureBus()\n", bus);
+      continue;
+    }
+    wire->setClock(bus_frequency_[bus]);
+    Serial.printf("I2C bus %d at %lu Hz\n", bus, (unsigned long)bus_frequency_[bus]);
+    
+    if (muxes_[bus]) {
+      // Start from a known state: every downstream channel off
+      if (muxes_[bus]->disableAll()) {
+        Serial.printf("TCA9548A mux at 0x%02X on bus %d\n", muxes_[bus]->getAddress(), bus);
+      } else {
+        Serial.printf("WARNING: TCA9548A mux at 0x%02X on bus %d not responding\n",
+                      muxes_[bus]->getAddress(), bus);
+      }
+    }
+  }
   Serial.println("I2C setup complete");
   
-  // Initialize drivers
-  Serial.println("Creating individual drivers...");
-  initializeDrivers();
-  
-  // Initialize each driver
+  // Initialize each board
   for (int i = 0; i < num_boards_; i++) {
-    if (drivers_[i]) {
-      Serial.printf("Initializing driver %d...\n", i);
-      
-      // Test I2C communication before initializing
-      ADDR addr_pin;
-      switch (i) {
-        case 0: addr_pin = ADDR::GND; break;
-        case 1: addr_pin = ADDR::VCC; break;
-        case 2: addr_pin = ADDR::SDA; break;
-        case 3: addr_pin = ADDR::SCL; break;
-        default: addr_pin = ADDR::GND; break;
-      }
-      
-      uint8_t i2c_addr = getI2CAddressFromADDR(addr_pin);
-      Wire.beginTransmission(i2c_addr);
-      uint8_t error = Wire.endTransmission();
-      
-      if (error != 0) {
-        Serial.printf("WARNING: Driver %d (0x%02X) not responding - skipping initialization\n", i, i2c_addr);
-        continue;
-      }
-      
-      drivers_[i]->begin();
-      drivers_[i]->setGlobalCurrent(50);
-      Serial.printf("Driver %d initialized successfully\n", i);
+    Serial.printf("Initializing driver %d...\n", i);
+    
+    // Test I2C communication before initializing
+    if (!chain_.probe(i)) {
+      Serial.printf("WARNING: Driver %d (bus %d, 0x%02X) not responding - skipping initialization\n",
+                    i, boards_[i].bus, chain_.getAddress(i));
+      continue;
     }
+    
+    if (!chain_.initializeBoard(i, DEFAULT_GLOBAL_CURRENT)) {
+      Serial.printf("WARNING: Driver %d register setup failed\n", i);
+      continue;
+    }
+    board_dirty_[i] = true;
+    Serial.printf("Driver %d initialized successfully\n", i);
   }
   
   Serial.println("Clearing all displays...");
@@ -77,10 +201,11 @@ bool DisplayManager::initialize() {
 
 bool DisplayManager::verifyDrivers() {
   Serial.println("Verifying LED driver communication...");
+  waitForFlush();  // Keep the buses to ourselves
   
   bool all_ok = true;
   for (int i = 0; i < num_boards_; i++) {
-    if (!drivers_[i]) {
+    if (!chain_.isOnline(i)) {
       Serial.printf("ERROR: Driver %d not initialized\n", i);
       all_ok = false;
       continue;
@@ -95,17 +220,19 @@ bool DisplayManager::verifyDrivers() {
       continue;
     }
     
-    // Test basic operations
-    drivers_[i]->clear();
-    drivers_[i]->drawPixel(0, 0, 100);
-    drivers_[i]->show();
+    // Test basic operations - light the first matrix LED directly
+    chain_.writePwmRegister(i, 0x00, 100);
     delay(100);  // Brief pause to see the test pixel
-    drivers_[i]->clear();
-    drivers_[i]->show();
+    chain_.writePwmRegister(i, 0x00, 0);
     
     Serial.printf("Driver %d verified successfully\n", i);
   }
   
+  // The test pattern bypassed the framebuffer - resend everything next flush
+  for (int i = 0; i < num_boards_; i++) {
+    invalidateBoard(i);
+  }
+  
   if (all_ok) {
     Serial.printf("✓ All %d display drivers verified successfully\n", num_boards_);
   } else {
@@ -116,74 +243,65 @@ bool DisplayManager::verifyDrivers() {
 }
 
 void DisplayManager::scanI2C() {
-  Serial.println("\nScanning I2C bus for devices...");
-  uint8_t device_count = 0;
+  waitForFlush();
   
-  for (uint8_t address = 1; address < 127; address++) {
-    Wire.beginTransmission(address);
-    uint8_t error = Wire.endTransmission();
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    if (!chain_.isBusUsed(bus)) continue;
     
-    if (error == 0) {
-      Serial.printf("I2C device found at address 0x%02X (%d)\n", address, address);
-      device_count++;
-    } else if (error == 4) {
-      // Only show timeout errors for expected LED driver addresses
-      if (address == 0x50 || address == 0x5A || address == 0x5F) {
-        Serial.printf("Timeout at expected LED driver address 0x%02X\n", address);
+    Tca9548aMux* mux = muxes_[bus];
+    int segments = mux ? Tca9548aMux::CHANNEL_COUNT : 1;
+    for (int segment = 0; segment < segments; segment++) {
+      if (mux) {
+        if (!mux->select(segment)) {
+          Serial.printf("\nMux on bus %d did not switch to channel %d\n", bus, segment);
+          continue;
+        }
+        Serial.printf("\nScanning I2C bus %d, mux channel %d for devices...\n", bus, segment);
+      } else {
+        Serial.printf("\nScanning I2C bus %d for devices...\n", bus);
+      }
+      
+      uint8_t device_count = 0;
+      for (uint8_t address = 1; address < 127; address++) {
+        if (mux && address == mux->getAddress()) continue;  // Visible on every channel
+        uint8_t error = wire_buses_[bus].probeError(address);
+        
+        if (error == 0) {
+          Serial.printf("I2C device found at address 0x%02X (%d)\n", address, address);
+          device_count++;
+        } else if (error == 4) {
+          // Only show timeout errors for expected LED driver addresses
+          if (address == 0x50 || address == 0x5A || address == 0x5F) {
+            Serial.printf("Timeout at expected LED driver address 0x%02X\n", address);
+          }
+        }
+      }
+      
+      if (device_count == 0) {
+        Serial.println("No I2C devices found via scan");
+      } else {
+        Serial.printf("Found %d I2C device(s) via scan\n", device_count);
       }
     }
   }
-  
-  if (device_count == 0) {
-    Serial.println("No I2C devices found via scan");
-  } else {
-    Serial.printf("Found %d I2C device(s) via scan\n", device_count);
-  }
   Serial.println("I2C scan complete\n");
 }
 
 void DisplayManager::setPixel(int x, int y, uint8_t brightness) {
   if (!isValidPosition(x, y)) return;
   
-  // Apply the same coordinate transformation as the old working code
-  int screen_x = total_width_ - x - 1;
-  int screen_y = total_height_ - y - 1;
-  
-  // Determine which board this pixel belongs to
-  int board = screen_x / board_width_;
-  if (board >= num_boards_ || !drivers_[board]) return;
-  
-  // Calculate local coordinates within the board (24x6 logical)
-  int local_x = screen_x % board_width_;  // 0-23
-  int local_y = screen_y;                 // 0-5
-  
-  // Convert 24x6 logical coordinates to 12x12 physical coordinates for RetroText PCB
-  // 6 characters in a line: chars 0,1,2 use SW1-6, chars 3,4,5 use SW7-12
-  int char_index = local_x / 4;  // Which character (0-5)
-  int char_pixel_x = local_x % 4;  // Pixel within character (0-3)
-  
-  int physical_x, physical_y;
+  int index = y * total_width_ + x;
+  uint8_t* buffer = drawBuffer();
+  if (buffer[index] == brightness) return;
   
-  if (char_index < 3) {
-    // Characters 0,1,2: use SW1-6 (top half)
-    physical_x = (char_index * 4) + char_pixel_x;  // CS1-4, CS5-8, CS9-12
-    physical_y = local_y;  // SW1-6 (rows 0-5)
-  } else {
-    // Characters 3,4,5: use SW7-12 (bottom half)  
-    physical_x = ((char_index - 3) * 4) + char_pixel_x;  // CS1-4, CS5-8, CS9-12
-    physical_y = local_y + 6;  // SW7-12 (rows 6-11)
-  }
-  
-  drivers_[board]->drawPixel(physical_x, physical_y, brightness);
+  buffer[index] = brightness;
+  markDrawn(index);
 }
 
 uint8_t DisplayManager::getPixel(int x, int y) const {
   if (!isValidPosition(x, y)) return 0;
   
-  // IS31FL373x drivers don't support pixel readback
-  // Return 0 - this is mainly used for debugging
-  // Most LED drivers don't support reading pixel values back
-  return 0;
+  return drawBuffer()[y * total_width_ + x];
 }
 
 bool DisplayManager::isValidPosition(int x, int y) const {
@@ -191,92 +309,368 @@ bool DisplayManager::isValidPosition(int x, int y) const {
 }
 
 void DisplayManager::clearBuffer() {
-  for (int i = 0; i < num_boards_; i++) {
-    if (drivers_[i]) {
-      drivers_[i]->clear();
-    }
-  }
+  fillBuffer(0);
 }
 
 void DisplayManager::fillBuffer(uint8_t brightness) {
-  // fillScreen doesn't exist in IS31FL373x driver, so implement manually
-  for (int y = 0; y < total_height_; y++) {
-    for (int x = 0; x < total_width_; x++) {
-      setPixel(x, y, brightness);
-    }
+  if (PixelKernels::fill(drawBuffer(), total_width_ * total_height_, brightness)) {
+    markAllDrawn();
   }
 }
 
 void DisplayManager::dimBuffer(uint8_t amount) {
-  // Use master brightness control for dimming effect
-  for (int i = 0; i < num_boards_; i++) {
-    if (drivers_[i]) {
-      uint8_t current_brightness = 255 - amount;
-      if (current_brightness < 10) current_brightness = 10;  // Minimum visibility
-      drivers_[i]->setMasterBrightness(current_brightness);
-    }
+  // Every pixel keeps (256 - amount) / 256 of its level, so repeated calls
+  // decay to black - trails and fade-outs
+  if (PixelKernels::fade(drawBuffer(), total_width_ * total_height_, amount)) {
+    markAllDrawn();
+  }
+}
+
+void DisplayManager::blendFrame(const uint8_t* pixels, BlendMode mode, uint8_t alpha) {
+  uint8_t* buffer = drawBuffer();
+  int count = total_width_ * total_height_;
+  switch (mode) {
+    case BLEND_REPLACE: PixelKernels::composeReplace(buffer, pixels, count); break;
+    case BLEND_ADD:     PixelKernels::composeAdd(buffer, pixels, count); break;
+    case BLEND_MAX:     PixelKernels::composeMax(buffer, pixels, count); break;
+    case BLEND_ALPHA:   PixelKernels::composeAlpha(buffer, pixels, count, alpha); break;
+  }
+  markAllDrawn();
+}
+
+void DisplayManager::setMasterBrightness(uint8_t brightness) {
+  // Scales every PWM value at flush time; the framebuffer is untouched
+  if (brightness != master_brightness_) {
+    waitForFlush();  // Don't rescale a frame part way through sending it
+    master_brightness_ = brightness;
+    markAllBoardsDirty();
   }
 }
 
 void DisplayManager::updateDisplay() {
+  present();
+}
+
+bool DisplayManager::startAsyncFlush(int core) {
+  if (async_flush_) return true;
+  
+  if (!flush_done_) {
+    flush_done_ = xSemaphoreCreateBinary();
+    if (!flush_done_) {
+      Serial.println("WARNING: Could not create flush semaphore - using synchronous flush");
+      return false;
+    }
+  }
+  
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    if (!chain_.isBusUsed(bus)) continue;
+    
+    BaseType_t result = xTaskCreatePinnedToCore(flushTaskEntry, "display_flush", 4096,
+                                                &flush_tasks_[bus], 1,
+                                                &flush_tasks_[bus].handle, core);
+    if (result != pdPASS) {
+      flush_tasks_[bus].handle = nullptr;
+      Serial.printf("WARNING: Could not start flush task for bus %d - using synchronous flush\n", bus);
+      for (int other = 0; other < bus; other++) {
+        if (flush_tasks_[other].handle) {
+          vTaskDelete(flush_tasks_[other].handle);
+          flush_tasks_[other].handle = nullptr;
+        }
+      }
+      return false;
+    }
+    Serial.printf("Display flush task for bus %d running on core %d\n", bus, core);
+  }
+  
+  async_flush_ = true;
+  return true;
+}
+
+void DisplayManager::present() {
+  if (layers_active_ && layers_changed_) {
+    composeLayers();
+  }
+  
+  // Nothing drawn since the last frame - no handoff, nothing to send
+  bool any_dirty = false;
+  for (int i = 0; i < num_boards_ && !any_dirty; i++) {
+    any_dirty = board_dirty_[i];
+  }
+  if (!any_dirty) return;
+  
+  if (!async_flush_) {
+    for (int bus = 0; bus < MAX_BUSES; bus++) {
+      transmitFrame(frame_buffer_, board_dirty_, bus);
+    }
+    return;
+  }
+  
+  // Previous frame still on the wire - this is the only point the render
+  // core waits, so drawing the next frame overlaps with transmission
+  waitForFlush();
+  
+  uint8_t* presented = frame_buffer_;
+  frame_buffer_ = front_buffer_;
+  front_buffer_ = presented;
+  
+  // Keep the back buffer's content so incremental drawing still works
+  memcpy(frame_buffer_, front_buffer_, total_width_ * total_height_);
   for (int i = 0; i < num_boards_; i++) {
-    if (drivers_[i]) {
-      drivers_[i]->show();
+    front_dirty_[i] = board_dirty_[i];
+    board_dirty_[i] = false;
+  }
+  
+  int task_count = 0;
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    if (flush_tasks_[bus].handle) task_count++;
+  }
+  flushes_pending_.store(task_count, std::memory_order_release);
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    if (flush_tasks_[bus].handle) {
+      xTaskNotifyGive(flush_tasks_[bus].handle);
     }
   }
 }
 
-void DisplayManager::drawCharacter(uint8_t character_pattern[6], int x_offset, uint8_t brightness) {
-  for (int row = 0; row < 6; row++) {
-    uint8_t pattern = character_pattern[row];
-    for (int col = 0; col < 4; col++) {
-      int x_pos = x_offset + (3 - col);  // Character positioning logic
-      if (x_pos >= 0 && x_pos < total_width_) {
-        if ((pattern & (1 << col)) != 0) {
-          setPixel(x_pos, row, brightness);
-        } else {
-          setPixel(x_pos, row, 0);
-        }
-      }
+void DisplayManager::waitForFlush() {
+  // Sleep until the last flush task gives flush_done_. A give left over
+  // from a frame nobody waited for only sends us round the loop again.
+  while (flushes_pending_.load(std::memory_order_acquire) > 0) {
+    xSemaphoreTake(flush_done_, portMAX_DELAY);
+  }
+}
+
+void DisplayManager::flushTaskEntry(void* arg) {
+  FlushTask* task = static_cast<FlushTask*>(arg);
+  DisplayManager* self = task->owner;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->transmitFrame(self->front_buffer_, self->front_dirty_, task->bus);
+    if (self->flushes_pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      xSemaphoreGive(self->flush_done_);  // Last bus done - wake the render core
     }
   }
 }
 
+void DisplayManager::transmitFrame(const uint8_t* frame, bool* dirty, int bus) {
+  chain_.flushBus(bus, frame, layout_.table(), total_width_ * total_height_, dirty, master_brightness_);
+}
+
+DisplayManager::FlushStats DisplayManager::getFlushStats() const {
+  FlushStats total = {0, 0, 0, 0, 0, 0};
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    const FlushStats& stats = chain_.getStats(bus);
+    total.bytes_last_frame += stats.bytes_last_frame;
+    total.bursts_last_frame += stats.bursts_last_frame;
+    total.boards_last_frame += stats.boards_last_frame;
+    total.selects_last_frame += stats.selects_last_frame;
+    total.bytes_total += stats.bytes_total;
+    if (stats.frames_total > total.frames_total) {
+      total.frames_total = stats.frames_total;
+    }
+  }
+  return total;
+}
+
+void DisplayManager::resetFlushStats() {
+  chain_.resetStats();
+}
+
+void DisplayManager::drawCharacter(uint8_t character_pattern[6], int x_offset, uint8_t brightness) {
+  // Font rows are 4 bits wide with bit 3 as the leftmost column
+  blitGlyph(character_pattern, 6, character_width_, x_offset, 0, brightness, 0);
+}
+
+void DisplayManager::drawGlyph(uint8_t character, int x_offset, uint8_t brightness, bool use_alt_font) {
+  if (x_offset >= total_width_ || x_offset + character_width_ <= 0) return;
+  
+  uint8_t pattern[6];
+  getGlyph(character, pattern, use_alt_font);
+  blitGlyph(pattern, 6, character_width_, x_offset, 0, brightness, 0);
+}
+
 void DisplayManager::drawText(const String& text, int start_x, uint8_t brightness, bool use_alt_font) {
   for (int i = 0; i < text.length(); i++) {
-    char c = text.charAt(i);
-    uint8_t character = c - 32; // ASCII offset
+    int char_x = start_x + (i * character_width_);
+    if (char_x >= total_width_) break;  // Rest of the text is off screen
+    
+    uint8_t character = text.charAt(i) - 32; // ASCII offset
+    drawGlyph(character, char_x, brightness, use_alt_font);
+  }
+}
+
+void DisplayManager::blitGlyph(const uint8_t* rows, int height, int width, int x, int y, uint8_t on, uint8_t off) {
+  // Clip the glyph rectangle once instead of bounds-checking every pixel
+  int first_col = x < 0 ? -x : 0;
+  int last_col = x + width > total_width_ ? total_width_ - x : width;
+  int first_row = y < 0 ? -y : 0;
+  int last_row = y + height > total_height_ ? total_height_ - y : height;
+  if (first_col >= last_col || first_row >= last_row) return;
+  
+  uint8_t* buffer = drawBuffer();
+  for (int row = first_row; row < last_row; row++) {
+    uint8_t bits = rows[row];
+    uint8_t mask = 1 << (width - 1 - first_col);
+    int index = (y + row) * total_width_ + x + first_col;
     
-    // Get character pattern
-    uint8_t pattern[6];
-    for (int row = 0; row < 6; row++) {
-      pattern[row] = getCharacterPattern(character, row, use_alt_font);
+    for (int col = first_col; col < last_col; col++, mask >>= 1, index++) {
+      uint8_t value = (bits & mask) ? on : off;
+      if (buffer[index] != value) {
+        buffer[index] = value;
+        markDrawn(index);
+      }
+    }
+  }
+}
+
+void DisplayManager::blitColumns(const uint8_t* masks, const uint8_t* levels, int count, int width,
+                                 int x, int y, int height, uint8_t fraction) {
+  int first_col = x < 0 ? -x : 0;
+  int last_col = x + width > total_width_ ? total_width_ - x : width;
+  int first_row = y < 0 ? -y : 0;
+  int last_row = y + height > total_height_ ? total_height_ - y : height;
+  if (first_col >= last_col || first_row >= last_row) return;
+  
+  // Sub-pixel: weigh each visible column against its right neighbour once,
+  // then every row is two masked adds per pixel
+  int visible = last_col - first_col;
+  uint8_t* left = blend_scratch_;
+  uint8_t* right = blend_scratch_ + total_width_;
+  uint8_t* blended = blend_scratch_ + total_width_ * 2;
+  int visible_count = count - first_col;
+  if (fraction) {
+    PixelKernels::blendWeights(levels + first_col, visible_count, visible, fraction, left, right);
+  }
+  
+  uint8_t* buffer = drawBuffer();
+  for (int row = first_row; row < last_row; row++) {
+    int index = (y + row) * total_width_ + x + first_col;
+    if (fraction) {
+      PixelKernels::blendRow(masks + first_col, visible_count, visible, row, left, right, blended);
     }
     
-    // Draw character
-    int char_x = start_x + (i * character_width_);
-    if (char_x < total_width_) {
-      drawCharacter(pattern, char_x, brightness);
+    for (int col = first_col; col < last_col; col++, index++) {
+      uint8_t value;
+      if (fraction) {
+        value = blended[col - first_col];
+      } else {
+        value = (col < count && (masks[col] >> row) & 1) ? levels[col] : 0;
+      }
+      if (buffer[index] != value) {
+        buffer[index] = value;
+        markDrawn(index);
+      }
     }
   }
 }
 
+void DisplayManager::enableLayer(Layer layer, BlendMode mode, uint8_t alpha) {
+  int pixels = total_width_ * total_height_;
+  layer_blend_[layer] = mode;
+  layer_alpha_[layer] = alpha;
+  layers_changed_ = true;
+  if (layer == LAYER_CONTENT || layer_enabled_[layer]) return;
+  
+  layer_buffers_[layer] = new uint8_t[pixels]();
+  layer_enabled_[layer] = true;
+  if (!layers_active_) {
+    // What is on screen now becomes the content layer
+    layer_buffers_[LAYER_CONTENT] = new uint8_t[pixels];
+    memcpy(layer_buffers_[LAYER_CONTENT], frame_buffer_, pixels);
+    compose_buffer_ = new uint8_t[pixels];
+    layers_active_ = true;
+  }
+}
+
+void DisplayManager::disableLayer(Layer layer) {
+  if (layer == LAYER_CONTENT || !layer_enabled_[layer]) return;
+  
+  layer_enabled_[layer] = false;
+  delete[] layer_buffers_[layer];
+  layer_buffers_[layer] = nullptr;
+  if (draw_layer_ == layer) {
+    draw_layer_ = LAYER_CONTENT;
+  }
+  
+  if (!layer_enabled_[LAYER_BACKGROUND] && !layer_enabled_[LAYER_OVERLAY]) {
+    // Last extra layer gone: the content layer becomes the frame again
+    composeLayers();
+    layers_active_ = false;
+    delete[] layer_buffers_[LAYER_CONTENT];
+    layer_buffers_[LAYER_CONTENT] = nullptr;
+    delete[] compose_buffer_;
+    compose_buffer_ = nullptr;
+  } else {
+    layers_changed_ = true;
+  }
+}
+
+void DisplayManager::setDrawLayer(Layer layer) {
+  if (layer_enabled_[layer]) {
+    draw_layer_ = layer;
+  }
+}
+
+void DisplayManager::composeLayers() {
+  // Stack the layers bottom up, then copy the result into the frame
+  // marking the boards whose pixels changed. A few hundred bytes per layer,
+  // one tight loop per layer.
+  int pixels = total_width_ * total_height_;
+  uint8_t* out = compose_buffer_;
+  memset(out, 0, pixels);
+  for (int layer = 0; layer < LAYER_COUNT; layer++) {
+    if (!layer_enabled_[layer]) continue;
+    const uint8_t* src = layer_buffers_[layer];
+    switch (layer_blend_[layer]) {
+      case BLEND_REPLACE: PixelKernels::composeReplace(out, src, pixels); break;
+      case BLEND_ADD:     PixelKernels::composeAdd(out, src, pixels); break;
+      case BLEND_MAX:     PixelKernels::composeMax(out, src, pixels); break;
+      case BLEND_ALPHA:   PixelKernels::composeAlpha(out, src, pixels, layer_alpha_[layer]); break;
+    }
+  }
+  
+  const PhysicalPixel* map = layout_.table();
+  for (int i = 0; i < pixels; i++) {
+    if (frame_buffer_[i] != out[i]) {
+      frame_buffer_[i] = out[i];
+      if (map[i].board != PanelLayout::NO_BOARD) {
+        board_dirty_[map[i].board] = true;
+      }
+    }
+  }
+  layers_changed_ = false;
+}
+
 void DisplayManager::setGlobalBrightness(uint8_t brightness) {
   for (int i = 0; i < num_boards_; i++) {
-    if (drivers_[i]) {
-      drivers_[i]->setGlobalCurrent(brightness);
-    }
+    setBoardBrightness(i, brightness);
   }
 }
 
 void DisplayManager::setBoardBrightness(int board_index, uint8_t brightness) {
-  if (board_index >= 0 && board_index < num_boards_ && drivers_[board_index]) {
-    drivers_[board_index]->setGlobalCurrent(brightness);
+  if (board_index >= 0 && board_index < num_boards_ && chain_.isOnline(board_index)) {
+    waitForFlush();
+    chain_.setGlobalCurrent(board_index, brightness);
   }
 }
 
 int DisplayManager::getBoardForPixel(int x) const {
-  return x / board_width_;
+  if (x < 0 || x >= total_width_) return -1;
+  uint8_t board = layout_.lookup(x, 0).board;
+  return board == PanelLayout::NO_BOARD ? -1 : board;
+}
+
+bool DisplayManager::setLayout(const BoardPlacement* placements, int count) {
+  for (int p = 0; p < count; p++) {
+    if (placements[p].board >= num_boards_) {
+      Serial.printf("setLayout: board %d is not in the %d-board chain\n", placements[p].board, num_boards_);
+      return false;
+    }
+  }
+  waitForFlush();  // The flush tasks read the table while sending
+  bool ok = layout_.build(placements, count, num_boards_, total_width_, total_height_, board_width_, board_height_);
+  markAllBoardsDirty();
+  return ok;
 }
 
 // mapPixelToBoard removed - IS31FL373x_Canvas handles multi-board coordinates directly
@@ -296,94 +690,120 @@ uint8_t DisplayManager::getCharacterPattern(uint8_t character, uint8_t row, bool
   return 0;
 }
 
+void DisplayManager::getGlyph(uint8_t character, uint8_t rows[6], bool use_alt_font) const {
+  // One range check per glyph instead of one per row
+  const uint8_t* font = use_alt_font ? modern_font4x6 : retro_font4x6;
+  size_t font_size = use_alt_font ? sizeof(modern_font4x6) : sizeof(retro_font4x6);
+  if (character > (font_size - 3) / 6) {
+    memset(rows, 0, 6);
+    return;
+  }
+  
+  const uint8_t* glyph = &font[3 + character * 6];
+  for (int row = 0; row < 6; row++) {
+    rows[row] = pgm_read_byte(&glyph[row]) >> 4;
+  }
+}
+
 // I2C functions removed - IS31FL373x driver handles I2C directly
 
 // Private helper methods
-void DisplayManager::initializeDrivers() {
-  Serial.printf("Creating %d individual drivers\n", num_boards_);
-  
-  for (int i = 0; i < num_boards_ && i < 4; i++) {
-    ADDR addr;
-    
-    // Initialize with the appropriate addresses for each board
-    switch (i) {
-      case 0: addr = ADDR::GND; break;
-      case 1: addr = ADDR::VCC; break;
-      case 2: addr = ADDR::SDA; break;
-      case 3: addr = ADDR::SCL; break;
-      default: addr = ADDR::GND; break;
+void DisplayManager::assignDefaultBoards() {
+  // Behind a mux on bus 0 every board shares that bus, 4 per channel;
+  // otherwise 4 boards per bus. ADDR settings repeat in GND/VCC/SDA/SCL order.
+  for (int i = 0; i < num_boards_; i++) {
+    uint8_t bus = muxes_[0] ? 0 : (i / BOARDS_PER_SEGMENT) % MAX_BUSES;
+    uint8_t channel = NO_MUX_CHANNEL;
+    if (muxes_[bus]) {
+      channel = (i / BOARDS_PER_SEGMENT) % Tca9548aMux::CHANNEL_COUNT;
     }
-    
-    Serial.printf("Creating driver %d with address %d\n", i, (int)addr);
-    drivers_[i] = new IS31FL3737(addr);
-    Serial.printf("Driver %d created successfully\n", i);
+    setBoardConfig(i, bus, DEFAULT_ADDR_ORDER[i % BOARDS_PER_SEGMENT], channel);
   }
   
-  Serial.println("All drivers created");
+  // Past 8 boards without a mux (32 with one) the defaults repeat
+  int first = 0, second = 0;
+  if (findSharedAddress(first, second)) {
+    Serial.printf("WARNING: %d boards need a mux or setBoardConfig() - board %d defaults to "
+                  "the same bus and ADDR as board %d\n", num_boards_, second, first);
+  }
 }
 
-void DisplayManager::convertLogicalToPhysical(int logical_x, int logical_y, int& physical_x, int& physical_y) {
-  // Convert 24x6 logical coordinates to 12x12 physical coordinates for RetroText PCB
-  // Based on PCB_Layout.md: 6 characters arranged horizontally
-  // Characters 0,1,2 use SW1-6 (CS1-4, CS5-8, CS9-12)
-  // Characters 3,4,5 use SW7-12 (CS1-4, CS5-8, CS9-12)
-  
-  int char_index = logical_x / 4;      // Which character (0-5)
-  int char_pixel_x = logical_x % 4;    // Pixel within character (0-3)
-  
-  if (char_index < 3) {
-    // Characters 0,1,2: top half of chip (SW1-6)
-    physical_x = (char_index * 4) + char_pixel_x;  // CS1-4, CS5-8, CS9-12
-    physical_y = logical_y;                         // SW1-6 (rows 0-5)
-  } else {
-    // Characters 3,4,5: bottom half of chip (SW7-12)
-    physical_x = ((char_index - 3) * 4) + char_pixel_x;  // CS1-4, CS5-8, CS9-12
-    physical_y = logical_y + 6;                           // SW7-12 (rows 6-11)
+bool DisplayManager::findSharedAddress(int& first, int& second) const {
+  for (int j = 1; j < num_boards_; j++) {
+    for (int i = 0; i < j; i++) {
+      if (boards_[i].bus == boards_[j].bus && boards_[i].mux_channel == boards_[j].mux_channel &&
+          boards_[i].addr == boards_[j].addr) {
+        first = i;
+        second = j;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void DisplayManager::markAllBoardsDirty() {
+  for (int i = 0; i < num_boards_; i++) {
+    board_dirty_[i] = true;
   }
 }
 
+void DisplayManager::invalidateBoard(int board) {
+  // Forget what the chip holds so the next flush rewrites the whole page
+  chain_.invalidate(board);
+  board_dirty_[board] = true;
+}
+
 void DisplayManager::printDisplayConfiguration() {
   Serial.println("\n=== RetroText Display Configuration ===");
   Serial.printf("Total displays: %d\n", num_boards_);
   Serial.printf("Display resolution: %dx%d (total: %dx%d)\n", 
                 board_width_, board_height_, total_width_, total_height_);
   Serial.printf("Characters per display: 6 (4x6 pixels each)\n");
-  Serial.printf("I2C bus speed: 800 kHz\n\n");
+  for (int bus = 0; bus < MAX_BUSES; bus++) {
+    if (chain_.isBusUsed(bus)) {
+      Serial.printf("I2C bus %d speed: %lu kHz\n", bus, (unsigned long)(bus_frequency_[bus] / 1000));
+    }
+  }
+  Serial.println();
   
-  Serial.println("Display Layout (Left to Right):");
+  waitForFlush();
+  Serial.println("Display Layout (board index, see PanelLayout for position):");
   Serial.println("┌─────────────────────────────────────────────────────────────┐");
-  Serial.println("│ Pos │ ADDR Pin │ I2C Addr │ Connection │ Status             │");
+  Serial.println("│ Pos │ ADDR Pin │ I2C Addr │ Bus   │ Mux │ Status              │");
   Serial.println("├─────────────────────────────────────────────────────────────┤");
   
   for (int i = 0; i < num_boards_; i++) {
-    ADDR addr_pin;
-    switch (i) {
-      case 0: addr_pin = ADDR::GND; break;
-      case 1: addr_pin = ADDR::VCC; break;
-      case 2: addr_pin = ADDR::SDA; break;
-      case 3: addr_pin = ADDR::SCL; break;
-      default: addr_pin = ADDR::GND; break;
-    }
-    
-    uint8_t i2c_addr = getI2CAddressFromADDR(addr_pin);
-    const char* pin_name = getADDRPinName(addr_pin);
+    uint8_t i2c_addr = chain_.getAddress(i);
+    const char* pin_name = getADDRPinName(boards_[i].addr);
+    const char* bus_name = boards_[i].bus == 0 ? "Wire" : "Wire1";
     
     // Test I2C communication
-    Wire.beginTransmission(i2c_addr);
-    uint8_t error = Wire.endTransmission();
-    
-    const char* status = (error == 0) ? "✓ Connected" : "✗ Not Found";
+    const char* status = chain_.probe(i) ? "✓ Connected" : "✗ Not Found";
     
-    Serial.printf("│  %d  │   %-6s │  0x%02X    │   %-8s │ %-18s │\n", 
-                  i, pin_name, i2c_addr, pin_name, status);
+    if (boards_[i].mux_channel == NO_MUX_CHANNEL) {
+      Serial.printf("│ %2d  │   %-6s │  0x%02X    │ %-5s │  -  │ %-19s │\n", 
+                    i, pin_name, i2c_addr, bus_name, status);
+    } else {
+      Serial.printf("│ %2d  │   %-6s │  0x%02X    │ %-5s │  %d  │ %-19s │\n", 
+                    i, pin_name, i2c_addr, bus_name, boards_[i].mux_channel, status);
+    }
   }
   
   Serial.println("└─────────────────────────────────────────────────────────────┘");
   Serial.println("\nPin Connections (standard I2C):");
   Serial.println("  VCC  → 3.3V");
   Serial.println("  GND  → Ground"); 
-  Serial.println("  SDA  → GPIO21 (ESP32)");
-  Serial.println("  SCL  → GPIO22 (ESP32)");
+  if (bus_sda_[0] >= 0) {
+    Serial.printf("  SDA  → GPIO%d (ESP32)\n", bus_sda_[0]);
+    Serial.printf("  SCL  → GPIO%d (ESP32)\n", bus_scl_[0]);
+  } else {
+    Serial.println("  SDA  → GPIO21 (ESP32)");
+    Serial.println("  SCL  → GPIO22 (ESP32)");
+  }
+  if (chain_.isBusUsed(1)) {
+    Serial.printf("  SDA1 → GPIO%d, SCL1 → GPIO%d (second bus)\n", bus_sda_[1], bus_scl_[1]);
+  }
   Serial.println("  ADDR → Connect to GND/VCC/SDA/SCL for addressing\n");
 }
 
@@ -409,25 +829,16 @@ const char* DisplayManager::getADDRPinName(ADDR addr) const {
 }
 
 bool DisplayManager::testDriverCommunication(int driver_index) {
-  if (driver_index >= num_boards_ || !drivers_[driver_index]) {
+  if (driver_index < 0 || driver_index >= num_boards_) {
     return false;
   }
   
   // Get the I2C address for this driver
-  ADDR addr_pin;
-  switch (driver_index) {
-    case 0: addr_pin = ADDR::GND; break;
-    case 1: addr_pin = ADDR::VCC; break;
-    case 2: addr_pin = ADDR::SDA; break;
-    case 3: addr_pin = ADDR::SCL; break;
-    default: return false;
-  }
-  
+  ADDR addr_pin = boards_[driver_index].addr;
   uint8_t i2c_addr = getI2CAddressFromADDR(addr_pin);
   
   // Test I2C communication
-  Wire.beginTransmission(i2c_addr);
-  uint8_t error = Wire.endTransmission();
+  uint8_t error = chain_.probe(driver_index) ? 0 : wire_buses_[boards_[driver_index].bus].probeError(i2c_addr);
   
   if (error != 0) {
     Serial.printf("  I2C Error %d for address 0x%02X (%s pin)\n", 
@@ -0,0 +1,134 @@
+#include "EffectRegistry.h"
+#include "DisplayManager.h"
+#include <string.h>
+
+static const uint32_t MAX_ELAPSED_MS = 250;   // After a pause, don't jump ahead
+static const uint8_t ADJUST_FRAMES = 8;       // Frames between budget changes
+
+EffectRegistry::EffectRegistry(DisplayManager* display_manager)
+  : display_manager_(display_manager)
+  , count_(0)
+  , selected_(-1)
+  , frame_(nullptr)
+  , budget_percent_(50)
+  , last_frame_(0)
+  , started_(false)
+  , frames_since_adjust_(0)
+{
+  memset(&stats_, 0, sizeof(stats_));
+  frame_ = new uint8_t[display_manager_->getWidth() * display_manager_->getHeight()];
+}
+
+EffectRegistry::~EffectRegistry() {
+  delete[] frame_;
+}
+
+int EffectRegistry::add(Effect* effect) {
+  if (!effect || count_ >= MAX_EFFECTS) return -1;
+  if (!effect->init(display_manager_->getWidth(), display_manager_->getHeight())) {
+    Serial.printf("Effect %s failed to initialize\n", effect->getName());
+    return -1;
+  }
+  effects_[count_] = effect;
+  return count_++;
+}
+
+int EffectRegistry::find(const char* name) const {
+  for (int i = 0; i < count_; i++) {
+    if (strcmp(effects_[i]->getName(), name) == 0) return i;
+  }
+  return -1;
+}
+
+void EffectRegistry::select(int index) {
+  if (index >= count_) index = -1;
+  if (selected_ >= 0 && index != selected_) {
+    effects_[selected_]->setDetailLevel(0);  // Leave it at full detail for next time
+  }
+
+  selected_ = index;
+  started_ = false;
+  frames_since_adjust_ = 0;
+  memset(&stats_, 0, sizeof(stats_));
+  if (selected_ >= 0) {
+    effects_[selected_]->reset();
+    effects_[selected_]->setDetailLevel(0);
+    stats_.budget_us = budgetUs(0);
+  }
+}
+
+bool EffectRegistry::update() {
+  if (selected_ < 0) return false;
+  Effect* effect = effects_[selected_];
+
+  unsigned long now = millis();
+  uint32_t elapsed = now - last_frame_;
+  if (!started_) {
+    elapsed = 0;  // First frame of a selection: draw the starting state
+    started_ = true;
+  } else if (elapsed < periodMs(stats_.skip)) {
+    return false;
+  }
+  // Clip only a real stall - a skipping effect's frames are meant to be long
+  uint32_t max_elapsed = max(MAX_ELAPSED_MS, periodMs(stats_.skip));
+  if (elapsed > max_elapsed) elapsed = max_elapsed;
+  last_frame_ = now;
+
+  unsigned long start = micros();
+  effect->update(elapsed);
+  effect->render(frame_);
+  uint32_t cost = micros() - start;
+
+  stats_.render_us_last = cost;
+  stats_.render_us_avg = stats_.frames_drawn ? (stats_.render_us_avg * 7 + cost) / 8 : cost;
+  stats_.frames_drawn++;
+  stats_.frames_skipped += stats_.skip;
+  adjustBudget();
+
+  // Transparent (0) pixels don't replace, so start from a clear frame
+  display_manager_->clearBuffer();
+  display_manager_->blendFrame(frame_);
+  display_manager_->updateDisplay();
+  return true;
+}
+
+uint32_t EffectRegistry::periodMs(uint8_t skip) const {
+  uint8_t fps = effects_[selected_]->getTargetFps();
+  if (fps == 0) fps = 1;
+  return (1000 / fps) * (skip + 1);
+}
+
+uint32_t EffectRegistry::budgetUs(uint8_t skip) const {
+  return periodMs(skip) * 10 * budget_percent_;  // ms * 1000 * percent / 100
+}
+
+void EffectRegistry::adjustBudget() {
+  // Let the average settle after every change before judging again
+  if (frames_since_adjust_ < ADJUST_FRAMES) {
+    frames_since_adjust_++;
+    return;
+  }
+
+  Effect* effect = effects_[selected_];
+  uint32_t cost = stats_.render_us_avg;
+  if (cost > budgetUs(stats_.skip)) {
+    // Over budget: cheaper frames first, then fewer of them
+    if (stats_.detail_level < effect->getMaxDetailLevel()) {
+      effect->setDetailLevel(++stats_.detail_level);
+    } else if (stats_.skip < MAX_SKIP) {
+      stats_.skip++;
+    } else {
+      return;
+    }
+  } else if (stats_.skip > 0 && cost * 4 < budgetUs(stats_.skip - 1) * 3) {
+    // Comfortably within the shorter period again (hysteresis avoids flapping)
+    stats_.skip--;
+  } else if (stats_.skip == 0 && stats_.detail_level > 0 && cost * 2 < budgetUs(0)) {
+    effect->setDetailLevel(--stats_.detail_level);
+  } else {
+    return;
+  }
+
+  stats_.budget_us = budgetUs(stats_.skip);
+  frames_since_adjust_ = 0;
+}
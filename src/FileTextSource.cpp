@@ -0,0 +1,38 @@
+#include "FileTextSource.h"
+
+FileTextSource::FileTextSource()
+  : length_(0)
+  , open_(false)
+{
+}
+
+FileTextSource::~FileTextSource() {
+  close();
+}
+
+bool FileTextSource::open(fs::FS& fs, const char* path) {
+  close();
+  file_ = fs.open(path, "r");
+  if (!file_ || file_.isDirectory()) {
+    Serial.printf("FileTextSource: cannot open %s\n", path);
+    return false;
+  }
+  length_ = file_.size();
+  open_ = true;
+  return true;
+}
+
+void FileTextSource::close() {
+  if (open_) {
+    file_.close();
+  }
+  length_ = 0;
+  open_ = false;
+}
+
+int FileTextSource::read(uint32_t position, char* out, int count) {
+  if (!open_ || position >= length_ || count <= 0) return 0;
+  if (file_.position() != position && !file_.seek(position)) return 0;
+  int got = file_.read(reinterpret_cast<uint8_t*>(out), count);
+  return got < 0 ? 0 : got;
+}
@@ -0,0 +1,170 @@
+#include "MessageQueue.h"
+
+namespace RetroText {
+
+MessageQueue::MessageQueue(SignTextController* sign, int capacity)
+  : sign_(sign)
+  , entries_(nullptr)
+  , capacity_(capacity)
+  , active_(-1)
+  , next_sequence_(0)
+  , started_at_(0)
+  , scrolled_through_(false)
+  , scrolled_through_at_(0)
+{
+  entries_ = new Entry[capacity_];
+  for (int i = 0; i < capacity_; i++) {
+    entries_[i].used = false;
+  }
+}
+
+MessageQueue::~MessageQueue() {
+  delete[] entries_;
+}
+
+bool MessageQueue::enqueue(const String& text, uint8_t priority, ScrollStyle style, uint32_t duration_ms) {
+  for (int i = 0; i < capacity_; i++) {
+    Entry& entry = entries_[i];
+    if (entry.used) continue;
+    
+    entry.text = text;
+    entry.priority = priority;
+    entry.style = style;
+    entry.duration_ms = (style == STATIC && duration_ms == 0) ? DEFAULT_STATIC_MS : duration_ms;
+    entry.sequence = next_sequence_++;
+    entry.shown_ms = 0;
+    entry.held_ms = 0;
+    entry.resume_pixels = 0;
+    entry.resume_fraction = 0;
+    entry.resume_chars = 0;
+    entry.interrupted = false;
+    entry.used = true;
+    return true;
+  }
+  return false;
+}
+
+bool MessageQueue::update() {
+  int next = pickNext();
+  if (active_ >= 0 && next >= 0 && entries_[next].priority > entries_[active_].priority) {
+    suspend();
+  }
+  if (active_ < 0) {
+    if (next < 0) return false;
+    start(next);
+  }
+  
+  advance();
+  if (!isActiveDone()) return true;
+  
+  // Free the slot and start the next message in this same call, so a
+  // message queued just before a blocking call is on screen during it.
+  // With nothing queued the last frame stays up.
+  entries_[active_].used = false;
+  entries_[active_].text = "";
+  active_ = -1;
+  next = pickNext();
+  if (next >= 0) {
+    start(next);
+    advance();
+  }
+  return true;
+}
+
+void MessageQueue::clear() {
+  for (int i = 0; i < capacity_; i++) {
+    entries_[i].used = false;
+    entries_[i].text = "";
+  }
+  active_ = -1;
+}
+
+bool MessageQueue::isIdle() const {
+  for (int i = 0; i < capacity_; i++) {
+    if (entries_[i].used) return false;
+  }
+  return true;
+}
+
+int MessageQueue::getPendingCount() const {
+  int count = 0;
+  for (int i = 0; i < capacity_; i++) {
+    if (entries_[i].used && i != active_) count++;
+  }
+  return count;
+}
+
+uint8_t MessageQueue::getCurrentPriority() const {
+  return active_ >= 0 ? entries_[active_].priority : 0;
+}
+
+int MessageQueue::pickNext() const {
+  // Highest priority, then oldest - an interrupted message keeps its
+  // original sequence number, so it resumes before newer ones
+  int best = -1;
+  for (int i = 0; i < capacity_; i++) {
+    const Entry& entry = entries_[i];
+    if (!entry.used || i == active_) continue;
+    if (best < 0 || entry.priority > entries_[best].priority ||
+        (entry.priority == entries_[best].priority && entry.sequence < entries_[best].sequence)) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+void MessageQueue::start(int index) {
+  Entry& entry = entries_[index];
+  sign_->setScrollStyle(entry.style);
+  sign_->setMessage(entry.text);
+  if (entry.interrupted) {
+    if (entry.style == CHARACTER) {
+      sign_->setScrollChars(entry.resume_chars);
+    } else if (entry.style == SMOOTH || entry.style == LOOP) {
+      sign_->setScrollPixels(entry.resume_pixels, entry.resume_fraction);
+    }
+  }
+  started_at_ = millis();
+  scrolled_through_ = false;
+  active_ = index;
+}
+
+void MessageQueue::advance() {
+  sign_->update();
+  if (!scrolled_through_ && sign_->isComplete()) {
+    scrolled_through_ = true;
+    scrolled_through_at_ = millis();
+  }
+}
+
+void MessageQueue::suspend() {
+  Entry& entry = entries_[active_];
+  entry.shown_ms += millis() - started_at_;
+  if (scrolled_through_) {
+    entry.held_ms += millis() - scrolled_through_at_;
+  }
+  entry.resume_pixels = sign_->getCurrentPixelOffset();
+  entry.resume_fraction = sign_->getSubpixelOffset();
+  entry.resume_chars = sign_->getCurrentCharPosition();
+  entry.interrupted = true;
+  active_ = -1;  // Stays queued
+}
+
+bool MessageQueue::isActiveDone() const {
+  const Entry& entry = entries_[active_];
+  if (entry.style == STATIC || entry.style == LOOP) {
+    // Total screen time, including any before an interruption. LOOP with
+    // 0 runs until cleared or preempted.
+    if (entry.style == LOOP && entry.duration_ms == 0) return false;
+    uint32_t shown = entry.shown_ms + (millis() - started_at_);
+    return shown >= entry.duration_ms;
+  }
+  
+  // Scrolling styles hold the final frame for duration_ms once through,
+  // counting any hold before an interruption. A resumed message is back
+  // through within a frame or two, as it was saved at the end.
+  if (!scrolled_through_) return false;
+  return entry.held_ms + (millis() - scrolled_through_at_) >= entry.duration_ms;
+}
+
+} // namespace RetroText
@@ -4,18 +4,22 @@ MeteorAnimation::MeteorAnimation(DisplayManager* display_manager)
   : display_manager_(display_manager)
   , num_meteors_(9)
   , num_stars_(24)
-  , frame_interval_(50)  // 20 FPS
+  , fps_(20)
+  , frame_interval_(50)
   , meteor_brightness_(150)
   , star_brightness_fast_(20)
   , star_brightness_slow_(8)
   , meteor_speed_multiplier_(1.0f)
   , star_speed_multiplier_(1.0f)
+  , layered_(false)
   , initialized_(false)
   , running_(false)
   , last_update_(0)
   , frame_count_(0)
-  , meteor_positions_(nullptr)
-  , star_positions_(nullptr)
+  , pending_ms_(0)
+  , stars_(nullptr)
+  , meteors_(nullptr)
+  , frame_(nullptr)
 {
 }
 
@@ -28,9 +32,17 @@ void MeteorAnimation::initialize() {
     cleanup();
   }
   
-  // Allocate memory for positions
-  meteor_positions_ = new float[num_meteors_];
-  star_positions_ = new float[num_stars_];
+  // Everything the animation needs, allocated once; frames allocate nothing
+  int display_width = display_manager_->getWidth();
+  int display_height = display_manager_->getHeight();
+  stars_ = new ParticleSystem(num_stars_, 0x5EED0001);
+  meteors_ = new ParticleSystem(num_meteors_, 0x5EED0002);
+  frame_ = new uint8_t[display_width * display_height];
+  
+  // Stars drift left and meteors streak right; both wrap around a margin
+  // off screen so they re-enter staggered
+  stars_->setBounds(-10, 0, display_width + 10, display_height, ParticleSystem::EDGE_WRAP);
+  meteors_->setBounds(-50, 0, display_width + 10, display_height, ParticleSystem::EDGE_WRAP);
   
   initializePositions();
   
@@ -51,16 +63,19 @@ void MeteorAnimation::update() {
     return;
   }
   
-  // Clear display
-  display_manager_->clearBuffer();
-  
-  // Update and draw stars (background)
-  updateStars();
-  drawStars();
-  
-  // Update and draw meteors (foreground)
-  updateMeteors();
-  drawMeteors();
+  stars_->step();
+  meteors_->step();
+  
+  if (layered_) {
+    // Each layer is redrawn on its own; the content layer is not touched
+    presentLayer(DisplayManager::LAYER_BACKGROUND, stars_);
+    presentLayer(DisplayManager::LAYER_OVERLAY, meteors_);
+    display_manager_->setDrawLayer(DisplayManager::LAYER_CONTENT);
+  } else {
+    render(frame_);
+    display_manager_->clearBuffer();
+    display_manager_->blendFrame(frame_);
+  }
   
   // Update display
   display_manager_->updateDisplay();
@@ -69,10 +84,46 @@ void MeteorAnimation::update() {
   frame_count_++;
 }
 
+bool MeteorAnimation::init(int width, int height) {
+  // Frames are always display sized
+  (void)width;
+  (void)height;
+  initialize();
+  return initialized_;
+}
+
+void MeteorAnimation::update(uint32_t elapsed_ms) {
+  if (!initialized_) return;
+  
+  // Particles move a fixed distance per step, so step once per frame
+  // interval that has passed - a skipped frame means two steps, not slower
+  // meteors
+  pending_ms_ += elapsed_ms;
+  int steps = 0;
+  while (pending_ms_ >= frame_interval_ && steps < 8) {
+    stars_->step();
+    meteors_->step();
+    pending_ms_ -= frame_interval_;
+    steps++;
+  }
+  if (pending_ms_ >= frame_interval_) pending_ms_ = 0;  // Too far behind - drop it
+  frame_count_++;
+}
+
+void MeteorAnimation::render(uint8_t* frame) {
+  // Stars (background) then meteors (foreground), the brighter pixel wins
+  int width = display_manager_->getWidth();
+  int height = display_manager_->getHeight();
+  PixelKernels::fill(frame, width * height, 0);
+  stars_->render(frame, width, height);
+  meteors_->render(frame, width, height);
+}
+
 void MeteorAnimation::reset() {
   if (initialized_) {
     initializePositions();
     frame_count_ = 0;
+    pending_ms_ = 0;
   }
 }
 
@@ -95,128 +146,108 @@ void MeteorAnimation::setNumStars(int num_stars) {
 }
 
 void MeteorAnimation::setFrameRate(int fps) {
-  if (fps > 0) {
-    frame_interval_ = 1000 / fps;
-  }
+  // Above 250 fps the interval would round to 0 ms (or past uint8_t)
+  fps_ = fps < 1 ? 1 : fps > 250 ? 250 : fps;
+  frame_interval_ = 1000 / fps_;
 }
 
 void MeteorAnimation::setBrightness(uint8_t meteor_brightness, uint8_t star_brightness_fast, uint8_t star_brightness_slow) {
   meteor_brightness_ = meteor_brightness;
   star_brightness_fast_ = star_brightness_fast;
   star_brightness_slow_ = star_brightness_slow;
+  applySettings();
 }
 
 void MeteorAnimation::setSpeed(float meteor_speed_multiplier, float star_speed_multiplier) {
   meteor_speed_multiplier_ = meteor_speed_multiplier;
   star_speed_multiplier_ = star_speed_multiplier;
+  applySettings();
 }
 
-void MeteorAnimation::initializePositions() {
-  if (!meteor_positions_ || !star_positions_) return;
+void MeteorAnimation::setLayered(bool layered) {
+  layered_ = layered;
+  if (!display_manager_) return;
   
-  int display_width = display_manager_->getWidth();
-  
-  // Initialize meteors at random negative positions to stagger their entry
-  for (int i = 0; i < num_meteors_; i++) {
-    meteor_positions_[i] = -10.0f - (rand() % 40);
-  }
-  
-  // Initialize stars at random positions across the display width
-  for (int i = 0; i < num_stars_; i++) {
-    star_positions_[i] = (float)(rand() % (display_width + 20));
+  if (layered) {
+    // Text on the content layer covers the stars; meteors pass over it
+    display_manager_->enableLayer(DisplayManager::LAYER_BACKGROUND, DisplayManager::BLEND_REPLACE);
+    display_manager_->enableLayer(DisplayManager::LAYER_OVERLAY, DisplayManager::BLEND_MAX);
+  } else {
+    display_manager_->disableLayer(DisplayManager::LAYER_BACKGROUND);
+    display_manager_->disableLayer(DisplayManager::LAYER_OVERLAY);
   }
 }
 
-void MeteorAnimation::updateMeteors() {
-  if (!meteor_positions_) return;
+void MeteorAnimation::initializePositions() {
+  if (!stars_ || !meteors_) return;
   
   int display_width = display_manager_->getWidth();
+  int display_height = display_manager_->getHeight();
   
+  // Meteors start at random negative positions to stagger their entry.
+  // Faster meteors (higher index) have longer trails.
+  meteors_->clear();
   for (int m = 0; m < num_meteors_; m++) {
-    // Meteor speed based on index - higher index = faster
-    float meteor_speed = (1.0f + (m * 0.2f)) * meteor_speed_multiplier_;
-    
-    // Move meteor
-    meteor_positions_[m] += meteor_speed;
-    
-    // Reset meteor when it goes off screen
-    if (meteor_positions_[m] > display_width + 10) {
-      meteor_positions_[m] = -15.0f - (m * 5); // Reset with staggered timing
-    }
+    int32_t x = (-10 - meteors_->random(0, 40)) * ParticleSystem::ONE;
+    int32_t y = (m % display_height) * ParticleSystem::ONE;  // Distribute meteors across all rows
+    meteors_->spawn(x, y, meteorVelocity(m), 0, meteor_brightness_, 3 + m / 2, 15);
   }
-}
-
-void MeteorAnimation::updateStars() {
-  if (!star_positions_) return;
-  
-  int display_width = display_manager_->getWidth();
   
+  // Stars at random positions across the display width
+  stars_->clear();
   for (int i = 0; i < num_stars_; i++) {
-    // Movement speed: odd stars faster, even stars slower
-    float move_speed = ((i % 2 == 0) ? 0.2f : 0.5f) * star_speed_multiplier_;
-    star_positions_[i] -= move_speed;
-    
-    // Reset star when it goes off screen
-    if (star_positions_[i] < -10) {
-      star_positions_[i] = display_width + 10;
-    }
+    int32_t x = stars_->random(0, display_width + 10) * ParticleSystem::ONE;
+    int32_t y = (i % display_height) * ParticleSystem::ONE;
+    stars_->spawn(x, y, starVelocity(i), 0, starBrightness(i));
   }
 }
 
-void MeteorAnimation::drawMeteors() {
-  if (!meteor_positions_) return;
-  
-  int display_width = display_manager_->getWidth();
-  int display_height = display_manager_->getHeight();
-  
-  for (int m = 0; m < num_meteors_; m++) {
-    int meteor_x = (int)meteor_positions_[m];
-    int meteor_y = m % display_height; // Distribute meteors across all rows
-    
-    // Trail length based on speed - faster meteors have longer trails
-    int trail_length = 3 + (m / 2); // 3-7 trails based on meteor index
-    
-    // Draw meteor trail (fading brightness)
-    for (int trail = 0; trail < trail_length; trail++) {
-      int trail_x = meteor_x - trail;
-      if (trail_x >= 0 && trail_x < display_width) {
-        uint8_t trail_brightness = meteor_brightness_ - (trail * 15);
-        if (trail_brightness > star_brightness_slow_) {
-          display_manager_->setPixel(trail_x, meteor_y, trail_brightness);
-        }
-      }
-    }
+void MeteorAnimation::applySettings() {
+  // Particles never expire here, so indexes still match spawn order
+  if (!stars_ || !meteors_) return;
+  for (int m = 0; m < meteors_->getCount(); m++) {
+    meteors_->setVelocity(m, meteorVelocity(m), 0);
+    meteors_->setBrightness(m, meteor_brightness_);
+  }
+  for (int i = 0; i < stars_->getCount(); i++) {
+    stars_->setVelocity(i, starVelocity(i), 0);
+    stars_->setBrightness(i, starBrightness(i));
   }
 }
 
-void MeteorAnimation::drawStars() {
-  if (!star_positions_) return;
-  
-  int display_width = display_manager_->getWidth();
-  int display_height = display_manager_->getHeight();
+int16_t MeteorAnimation::meteorVelocity(int index) const {
+  // Higher index = faster
+  return (int16_t)((1.0f + index * 0.2f) * meteor_speed_multiplier_ * ParticleSystem::ONE);
+}
+
+int16_t MeteorAnimation::starVelocity(int index) const {
+  // Odd stars move faster (nearer), even stars slower
+  return (int16_t)(-((index % 2 == 0) ? 0.2f : 0.5f) * star_speed_multiplier_ * ParticleSystem::ONE);
+}
+
+uint8_t MeteorAnimation::starBrightness(int index) const {
+  // Odd stars are brighter, even stars dimmer
+  return (index % 2 == 0) ? star_brightness_slow_ : star_brightness_fast_;
+}
+
+void MeteorAnimation::presentLayer(DisplayManager::Layer layer, const ParticleSystem* particles) {
+  int width = display_manager_->getWidth();
+  int height = display_manager_->getHeight();
+  PixelKernels::fill(frame_, width * height, 0);
+  particles->render(frame_, width, height);
   
-  for (int i = 0; i < num_stars_; i++) {
-    int star_x = (int)star_positions_[i] % (display_width + 10);
-    int star_y = (i % display_height); // Distribute stars across all rows
-    
-    if (star_x >= 0 && star_x < display_width) {
-      // Odd stars move faster and are brighter, even stars move slower and are dimmer
-      uint8_t star_brightness = (i % 2 == 0) ? star_brightness_slow_ : star_brightness_fast_;
-      display_manager_->setPixel(star_x, star_y, star_brightness);
-    }
-  }
+  display_manager_->setDrawLayer(layer);
+  display_manager_->clearBuffer();
+  display_manager_->blendFrame(frame_);
 }
 
 void MeteorAnimation::cleanup() {
-  if (meteor_positions_) {
-    delete[] meteor_positions_;
-    meteor_positions_ = nullptr;
-  }
-  
-  if (star_positions_) {
-    delete[] star_positions_;
-    star_positions_ = nullptr;
-  }
+  delete stars_;
+  delete meteors_;
+  delete[] frame_;
+  stars_ = nullptr;
+  meteors_ = nullptr;
+  frame_ = nullptr;
   
   initialized_ = false;
 }
@@ -0,0 +1,109 @@
+#include "PanelLayout.h"
+
+PanelLayout::PanelLayout()
+  : width_(0)
+  , height_(0)
+  , table_(nullptr)
+{
+}
+
+PanelLayout::~PanelLayout() {
+  delete[] table_;
+}
+
+bool PanelLayout::build(const BoardPlacement* placements, int count, int num_boards, int width, int height,
+                        int board_width, int board_height) {
+  if (width <= 0 || height <= 0) return false;
+  
+  // Board indexes go straight into per-board arrays when pixels are drawn
+  for (int p = 0; p < count; p++) {
+    if (placements[p].board >= num_boards) return false;
+  }
+
+  if (width != width_ || height != height_) {
+    delete[] table_;
+    table_ = new PhysicalPixel[width * height];
+    width_ = width;
+    height_ = height;
+  }
+
+  for (int i = 0; i < width * height; i++) {
+    table_[i].board = NO_BOARD;
+    table_[i].x = 0;
+    table_[i].y = 0;
+    table_[i].pwm_register = 0;
+  }
+
+  bool ok = true;
+  for (int p = 0; p < count; p++) {
+    const BoardPlacement& placement = placements[p];
+    bool quarter_turn = placement.rotation == BoardRotation::ROTATE_90 ||
+                        placement.rotation == BoardRotation::ROTATE_270;
+    int footprint_w = quarter_turn ? board_height : board_width;
+    int footprint_h = quarter_turn ? board_width : board_height;
+
+    for (int fy = 0; fy < footprint_h; fy++) {
+      for (int fx = 0; fx < footprint_w; fx++) {
+        int x = placement.x + fx;
+        int y = placement.y + fy;
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+          ok = false;
+          continue;
+        }
+
+        // Undo the mounting transform to get the board-native 24x6 position
+        int lx = placement.mirror ? (footprint_w - 1 - fx) : fx;
+        int ly = fy;
+        int bx, by;
+        switch (placement.rotation) {
+          case BoardRotation::ROTATE_90:  bx = ly;                    by = board_height - 1 - lx; break;
+          case BoardRotation::ROTATE_180: bx = board_width - 1 - lx;  by = board_height - 1 - ly; break;
+          case BoardRotation::ROTATE_270: bx = board_width - 1 - ly;  by = lx;                    break;
+          default:                        bx = lx;                    by = ly;                    break;
+        }
+
+        PhysicalPixel& entry = table_[y * width + x];
+        if (entry.board != NO_BOARD) ok = false;  // Overlap - last placement wins
+        entry.board = placement.board;
+        foldToMatrix(bx, by, entry.x, entry.y);
+        entry.pwm_register = pwmRegister(entry.x, entry.y);
+      }
+    }
+  }
+
+  return ok;
+}
+
+int PanelLayout::defaultChain(int num_boards, int board_width, int board_height, BoardPlacement* out) {
+  return defaultGrid(num_boards, 1, board_width, board_height, out);
+}
+
+int PanelLayout::defaultGrid(int columns, int board_rows, int board_width, int board_height, BoardPlacement* out) {
+  int total_width = columns * board_width;
+  int count = 0;
+  for (int row = 0; row < board_rows; row++) {
+    for (int i = 0; i < columns; i++) {
+      out[count].board = count;
+      out[count].x = total_width - (i + 1) * board_width;
+      out[count].y = row * board_height;
+      out[count].rotation = BoardRotation::ROTATE_180;
+      out[count].mirror = false;
+      count++;
+    }
+  }
+  return count;
+}
+
+void PanelLayout::foldToMatrix(int local_x, int local_y, uint8_t& matrix_x, uint8_t& matrix_y) {
+  // 6 characters in a line: chars 0,1,2 use SW1-6, chars 3,4,5 use SW7-12
+  int char_index = local_x / 4;      // Which character (0-5)
+  int char_pixel_x = local_x % 4;    // Pixel within character (0-3)
+
+  if (char_index < 3) {
+    matrix_x = (char_index * 4) + char_pixel_x;          // CS1-4, CS5-8, CS9-12
+    matrix_y = local_y;                                  // SW1-6 (rows 0-5)
+  } else {
+    matrix_x = ((char_index - 3) * 4) + char_pixel_x;    // CS1-4, CS5-8, CS9-12
+    matrix_y = local_y + 6;                              // SW7-12 (rows 6-11)
+  }
+}
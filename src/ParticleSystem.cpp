@@ -0,0 +1,130 @@
+#include "ParticleSystem.h"
+
+ParticleSystem::ParticleSystem(int capacity, uint32_t seed)
+  : capacity_(capacity)
+  , count_(0)
+  , rng_(seed)
+  , min_x_(0)
+  , min_y_(0)
+  , max_x_(0)
+  , max_y_(0)
+  , edge_mode_(EDGE_KILL)
+{
+  x_ = new int32_t[capacity_];
+  y_ = new int32_t[capacity_];
+  vx_ = new int16_t[capacity_];
+  vy_ = new int16_t[capacity_];
+  brightness_ = new uint8_t[capacity_];
+  trail_length_ = new uint8_t[capacity_];
+  trail_decay_ = new uint8_t[capacity_];
+  lifetime_ = new uint16_t[capacity_];
+}
+
+ParticleSystem::~ParticleSystem() {
+  delete[] x_;
+  delete[] y_;
+  delete[] vx_;
+  delete[] vy_;
+  delete[] brightness_;
+  delete[] trail_length_;
+  delete[] trail_decay_;
+  delete[] lifetime_;
+}
+
+void ParticleSystem::setBounds(int min_x, int min_y, int max_x, int max_y, EdgeMode mode) {
+  min_x_ = min_x * ONE;
+  min_y_ = min_y * ONE;
+  max_x_ = max_x * ONE;
+  max_y_ = max_y * ONE;
+  edge_mode_ = mode;
+}
+
+int ParticleSystem::spawn(int32_t x, int32_t y, int16_t vx, int16_t vy, uint8_t brightness,
+                          uint8_t trail_length, uint8_t trail_decay, uint16_t lifetime_steps) {
+  if (count_ >= capacity_) return -1;
+  
+  int i = count_++;
+  x_[i] = x;
+  y_[i] = y;
+  vx_[i] = vx;
+  vy_[i] = vy;
+  brightness_[i] = brightness;
+  trail_length_[i] = trail_length ? trail_length : 1;
+  trail_decay_[i] = trail_decay;
+  lifetime_[i] = lifetime_steps;
+  return i;
+}
+
+void ParticleSystem::step() {
+  int32_t width = max_x_ - min_x_;
+  int32_t height = max_y_ - min_y_;
+  
+  // Integrate every particle first - one pass per field keeps the loops
+  // tight; the rarer edge and lifetime handling follows
+  for (int i = 0; i < count_; i++) {
+    x_[i] += vx_[i];
+  }
+  for (int i = 0; i < count_; i++) {
+    y_[i] += vy_[i];
+  }
+  
+  for (int i = 0; i < count_; ) {
+    bool dead = false;
+    if (lifetime_[i] && --lifetime_[i] == 0) {
+      dead = true;
+    }
+    
+    bool outside = x_[i] < min_x_ || x_[i] >= max_x_ || y_[i] < min_y_ || y_[i] >= max_y_;
+    if (outside && !dead) {
+      if (edge_mode_ == EDGE_KILL || width <= 0 || height <= 0) {
+        dead = true;
+      } else {
+        // Keep the overshoot so wrapped particles stay evenly spaced
+        while (x_[i] < min_x_) x_[i] += width;
+        while (x_[i] >= max_x_) x_[i] -= width;
+        while (y_[i] < min_y_) y_[i] += height;
+        while (y_[i] >= max_y_) y_[i] -= height;
+      }
+    }
+    
+    if (dead) {
+      remove(i);  // Index i now holds the last particle - check it next
+    } else {
+      i++;
+    }
+  }
+}
+
+void ParticleSystem::render(uint8_t* frame, int width, int height) const {
+  for (int i = 0; i < count_; i++) {
+    int px = x_[i] >> FRACTION_BITS;   // Floor, also for negative positions
+    int py = y_[i] >> FRACTION_BITS;
+    if (py < 0 || py >= height) continue;
+    
+    // The trail runs back along the horizontal direction of travel
+    int direction = vx_[i] > 0 ? -1 : 1;
+    int level = brightness_[i];
+    uint8_t* row = frame + py * width;
+    for (int k = 0; k < trail_length_[i] && level > 0; k++, px += direction, level -= trail_decay_[i]) {
+      if (px < 0 || px >= width) continue;
+      if (row[px] < level) row[px] = level;
+    }
+  }
+}
+
+int ParticleSystem::random(int min, int max) {
+  if (max <= min) return min;
+  return min + (int)(random() % (uint32_t)(max - min));
+}
+
+void ParticleSystem::remove(int index) {
+  int last = --count_;
+  x_[index] = x_[last];
+  y_[index] = y_[last];
+  vx_[index] = vx_[last];
+  vy_[index] = vy_[last];
+  brightness_[index] = brightness_[last];
+  trail_length_[index] = trail_length_[last];
+  trail_decay_[index] = trail_decay_[last];
+  lifetime_[index] = lifetime_[last];
+}
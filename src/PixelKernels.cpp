@@ -0,0 +1,176 @@
+#include "PixelKernels.h"
+#include <string.h>
+
+void PixelKernels::blendWeights(const uint8_t* levels, int count, int width, uint8_t fraction,
+                                uint8_t* left, uint8_t* right) {
+  uint16_t keep = 256 - fraction;
+  for (int i = 0; i < width; i++) {
+    left[i] = i < count ? (levels[i] * keep) >> 8 : 0;
+    right[i] = i + 1 < count ? (levels[i + 1] * fraction) >> 8 : 0;
+  }
+}
+
+void PixelKernels::blendRow(const uint8_t* masks, int count, int width, int row,
+                            const uint8_t* left, const uint8_t* right, uint8_t* out) {
+  // Columns with a right neighbour in the strip, then the ragged tail
+  int paired = count - 1 < width ? count - 1 : width;
+  int i = 0;
+  for (; i < paired; i++) {
+    uint8_t a = -((masks[i] >> row) & 1);      // 0x00 or 0xFF
+    uint8_t b = -((masks[i + 1] >> row) & 1);
+    out[i] = (a & left[i]) + (b & right[i]);
+  }
+  for (; i < width; i++) {
+    out[i] = i < count ? (uint8_t)(-((masks[i] >> row) & 1)) & left[i] : 0;
+  }
+}
+
+// SWAR helpers: a 32-bit word holds 4 pixels, one per byte lane. Every
+// lane operation keeps its carries inside the lane.
+static const uint32_t LANE_HIGH_BITS = 0x80808080;
+static const uint32_t LANE_LOW_BITS = 0x7F7F7F7F;
+static const uint32_t EVEN_LANES = 0x00FF00FF;
+
+static inline bool wordAligned(const void* a, const void* b) {
+  return (((uintptr_t)a | (uintptr_t)b) & 3) == 0;
+}
+
+static inline uint32_t load4(const uint8_t* p) {
+  uint32_t word;
+  memcpy(&word, __builtin_assume_aligned(p, 4), 4);
+  return word;
+}
+
+static inline void store4(uint8_t* p, uint32_t word) {
+  memcpy(__builtin_assume_aligned(p, 4), &word, 4);
+}
+
+// 0xFF in every lane whose high bit is set in `flags`
+static inline uint32_t laneMask(uint32_t flags) {
+  return ((flags & LANE_HIGH_BITS) >> 7) * 0xFF;
+}
+
+// 0xFF in every non-zero lane
+static inline uint32_t litMask(uint32_t word) {
+  return laneMask(((word & LANE_LOW_BITS) + LANE_LOW_BITS) | word);
+}
+
+// Every lane times scale / 256, scale at most 256
+static inline uint32_t scaleLanes(uint32_t word, uint16_t scale) {
+  uint32_t even = (((word & EVEN_LANES) * scale) >> 8) & EVEN_LANES;
+  uint32_t odd = (((word >> 8) & EVEN_LANES) * scale) & ~EVEN_LANES;
+  return even | odd;
+}
+
+bool PixelKernels::fill(uint8_t* dst, int count, uint8_t value) {
+  uint32_t pattern = value * 0x01010101u;
+  uint32_t changed = 0;
+  int i = 0;
+  if (wordAligned(dst, dst)) {
+    for (; i + 4 <= count; i += 4) {
+      changed |= load4(dst + i) ^ pattern;
+      store4(dst + i, pattern);
+    }
+  }
+  for (; i < count; i++) {
+    changed |= dst[i] ^ value;
+    dst[i] = value;
+  }
+  return changed != 0;
+}
+
+bool PixelKernels::fade(uint8_t* dst, int count, uint8_t amount) {
+  uint16_t scale = 256 - amount;
+  uint32_t changed = 0;
+  int i = 0;
+  if (wordAligned(dst, dst)) {
+    for (; i + 4 <= count; i += 4) {
+      uint32_t word = load4(dst + i);
+      if (!word) continue;                       // Dark stays dark, skip the store
+      uint32_t faded = scaleLanes(word, scale);
+      changed |= word ^ faded;
+      store4(dst + i, faded);
+    }
+  }
+  for (; i < count; i++) {
+    uint8_t faded = (dst[i] * scale) >> 8;
+    changed |= dst[i] ^ faded;
+    dst[i] = faded;
+  }
+  return changed != 0;
+}
+
+void PixelKernels::composeReplace(uint8_t* dst, const uint8_t* src, int count) {
+  int i = 0;
+  if (wordAligned(dst, src)) {
+    for (; i + 4 <= count; i += 4) {
+      uint32_t s = load4(src + i);
+      uint32_t lit = litMask(s);
+      store4(dst + i, (s & lit) | (load4(dst + i) & ~lit));
+    }
+  }
+  for (; i < count; i++) {
+    uint8_t lit = -(src[i] != 0);               // 0x00 or 0xFF
+    dst[i] = (src[i] & lit) | (dst[i] & ~lit);
+  }
+}
+
+void PixelKernels::composeAdd(uint8_t* dst, const uint8_t* src, int count) {
+  int i = 0;
+  if (wordAligned(dst, src)) {
+    for (; i + 4 <= count; i += 4) {
+      // Add the low 7 bits, put the high bits back, then saturate the lanes
+      // that carried out of bit 7
+      uint32_t a = load4(dst + i);
+      uint32_t b = load4(src + i);
+      uint32_t low = (a & LANE_LOW_BITS) + (b & LANE_LOW_BITS);
+      uint32_t sum = low ^ ((a ^ b) & LANE_HIGH_BITS);
+      uint32_t carry = (a & b) | ((a | b) & low);
+      store4(dst + i, sum | laneMask(carry));
+    }
+  }
+  for (; i < count; i++) {
+    uint16_t sum = dst[i] + src[i];
+    dst[i] = sum > 255 ? 255 : sum;
+  }
+}
+
+void PixelKernels::composeMax(uint8_t* dst, const uint8_t* src, int count) {
+  int i = 0;
+  if (wordAligned(dst, src)) {
+    for (; i + 4 <= count; i += 4) {
+      // Per lane a >= b: decided by the high bits when they differ, else by
+      // a borrow-free compare of the low 7 bits
+      uint32_t a = load4(dst + i);
+      uint32_t b = load4(src + i);
+      uint32_t low_ge = (a | LANE_HIGH_BITS) - (b & LANE_LOW_BITS);
+      uint32_t a_ge = laneMask((a & ~b) | (~(a ^ b) & low_ge));
+      store4(dst + i, (a & a_ge) | (b & ~a_ge));
+    }
+  }
+  for (; i < count; i++) {
+    if (src[i] > dst[i]) dst[i] = src[i];
+  }
+}
+
+void PixelKernels::composeAlpha(uint8_t* dst, const uint8_t* src, int count, uint8_t alpha) {
+  // dst + (src - dst) * alpha / 256 == (dst * (256 - alpha) + src * alpha) / 256,
+  // which splits into even and odd lanes without sign handling
+  uint16_t keep = 256 - alpha;
+  int i = 0;
+  if (wordAligned(dst, src)) {
+    for (; i + 4 <= count; i += 4) {
+      uint32_t a = load4(dst + i);
+      uint32_t b = load4(src + i);
+      uint32_t even = (((a & EVEN_LANES) * keep + (b & EVEN_LANES) * alpha) >> 8) & EVEN_LANES;
+      uint32_t odd = (((a >> 8) & EVEN_LANES) * keep + ((b >> 8) & EVEN_LANES) * alpha) & ~EVEN_LANES;
+      uint32_t lit = litMask(b);
+      store4(dst + i, ((even | odd) & lit) | (a & ~lit));
+    }
+  }
+  for (; i < count; i++) {
+    if (src[i]) {
+      dst[i] = (dst[i] * keep + src[i] * alpha) >> 8;
+    }
+  }
+}
@@ -0,0 +1,57 @@
+#include "ShaderEffect.h"
+
+static const uint8_t SHADER_PEAK = 96;   // Full shader output maps to this level
+static const int WAVE_ROW_HEIGHT = 6;    // Waves repeat per board row
+
+ShaderEffect::ShaderEffect(const char* name, PixelShader shader, uint8_t fps)
+  : name_(name)
+  , shader_(shader)
+  , fps_(fps)
+  , detail_level_(0)
+  , width_(0)
+  , height_(0)
+  , time_ms_(0)
+{
+}
+
+bool ShaderEffect::init(int width, int height) {
+  width_ = width;
+  height_ = height;
+  return shader_ != nullptr;
+}
+
+void ShaderEffect::render(uint8_t* frame) {
+  evaluate(shader_, frame, width_, height_, time_ms_, 1 << detail_level_);
+}
+
+uint8_t ShaderEffect::plasma(int x, int y, uint32_t t) {
+  uint8_t fast = t >> 4;   // One turn in ~4 s
+  uint8_t slow = t >> 5;
+  int sum = FixedMath::sin8(x * 7 + fast) +
+            FixedMath::sin8(y * 23 - slow) +
+            FixedMath::sin8(x * 3 + y * 11 + FixedMath::sin8(slow));
+  uint8_t level = FixedMath::sin8(sum / 3 + fast);
+  return FixedMath::scale8(FixedMath::gamma8(level), SHADER_PEAK);
+}
+
+uint8_t ShaderEffect::waves(int x, int y, uint32_t t) {
+  // Line height in 1/255 row units, swinging over the board's rows
+  int centre = FixedMath::sin8(x * 6 + (t >> 3)) * (WAVE_ROW_HEIGHT - 1);
+  int distance = (y % WAVE_ROW_HEIGHT) * 255 - centre;
+  if (distance < 0) distance = -distance;
+  if (distance >= 255) return 0;
+  return FixedMath::scale8(FixedMath::gamma8(255 - distance), SHADER_PEAK);
+}
+
+uint8_t ShaderEffect::gradient(int x, int y, uint32_t t) {
+  uint8_t level = FixedMath::sin8(x * 4 - (t >> 4));
+  level = FixedMath::scale8(level, 255 - (y % WAVE_ROW_HEIGHT) * 12);   // Darker towards each row's bottom
+  return FixedMath::scale8(FixedMath::gamma8(level), SHADER_PEAK);
+}
+
+uint8_t ShaderEffect::clouds(int x, int y, uint32_t t) {
+  // About six pixels per noise cell, drifting one cell per second. The
+  // coordinate wraps every ~262 s; noise8 tiles, so the clouds don't jump.
+  uint8_t level = FixedMath::noise8(x * 40 + (t >> 2), y * 48);
+  return FixedMath::scale8(FixedMath::gamma8(level), SHADER_PEAK);
+}
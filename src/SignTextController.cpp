@@ -11,51 +11,151 @@ SignTextController::SignTextController(int display_width_chars, int char_width_p
   , current_font_(MODERN_FONT)
   , scroll_style_(SMOOTH)
   , scroll_speed_ms_(50)
+  , scroll_velocity_(0)
+  , scroll_easing_(EASE_LINEAR)
+  , scroll_ramp_ms_(500)
+  , subpixel_scroll_(false)
+  , loop_gap_chars_(3)
   , default_brightness_(NORMAL)
   , message_("")
+  , source_(nullptr)
+  , live_source_(nullptr)
+  , live_capacity_(512)
+  , window_text_(nullptr)
+  , window_capacity_(display_width_chars + 2 + WINDOW_HISTORY + WINDOW_READ_AHEAD)
+  , window_start_(0)
+  , window_count_(0)
+  , window_valid_(false)
+  , loop_length_(0)
   , scroll_char_position_(0)
   , scroll_pixel_offset_(0)
-  , last_update_time_(0)
+  , scroll_fraction_(0)
+  , scroll_origin_time_(0)
+  , scroll_origin_step_(0)
+  , scroll_anchored_(false)
+  , scroll_ramp_in_(true)
   , scroll_complete_(false)
+  , repeat_(false)
+  , skipped_steps_(0)
+  , frame_valid_(false)
+  , rendered_offset_(0)
+  , rendered_fraction_(0)
+  , rendered_length_(0)
+  , style_rule_(nullptr)
+  , attributes_(nullptr)
+  , attributes_valid_(false)
   , display_manager_(nullptr)
+  , viewport_x_(0)
+  , viewport_y_(0)
+  , auto_present_(true)
+  , shared_display_(false)
+  , draw_count_(0)
   , render_callback_(nullptr)
   , clear_callback_(nullptr)
   , draw_callback_(nullptr)
   , brightness_callback_(nullptr)
+  , on_complete_(nullptr)
+  , on_wrap_(nullptr)
+  , strip_mask_(nullptr)
+  , strip_brightness_(nullptr)
+  , strip_columns_(0)
+  , strip_capacity_(0)
+  , strip_chars_(0)
+  , strip_valid_(false)
+  , cell_text_(nullptr)
+  , cell_brightness_(nullptr)
+  , cells_valid_(false)
+  , cells_version_(0)
 {
   // Initialize highlights as inactive
   for (int i = 0; i < MAX_HIGHLIGHTS; i++) {
     highlights_[i].active = false;
   }
+  
+  window_text_ = new char[window_capacity_];
+  attributes_ = new CharAttributes[window_capacity_];
+  cell_text_ = new char[display_width_chars_];
+  cell_brightness_ = new uint8_t[display_width_chars_];
 }
 
 SignTextController::~SignTextController() {
-  // Nothing to clean up currently
+  delete[] window_text_;
+  delete[] attributes_;
+  delete[] strip_mask_;
+  delete[] strip_brightness_;
+  delete live_source_;
+  delete[] cell_text_;
+  delete[] cell_brightness_;
 }
 
 void SignTextController::setFont(Font font) {
   current_font_ = font;
+  invalidateStrip();
+  cells_valid_ = false;
 }
 
 void SignTextController::setScrollStyle(ScrollStyle style) {
   scroll_style_ = style;
+  invalidateWindow();  // Spacing depends on the style, LOOP reads the text wrapped
   resetScroll();
 }
 
 void SignTextController::setScrollSpeed(int speed_ms) {
   scroll_speed_ms_ = speed_ms;
+  scroll_velocity_ = 0;
+  scroll_anchored_ = false;  // Continue from the current position at the new speed
+}
+
+void SignTextController::setScrollVelocity(float pixels_per_second) {
+  scroll_velocity_ = pixels_per_second;
+  scroll_anchored_ = false;
+}
+
+float SignTextController::getScrollVelocity() const {
+  int step_pixels = scroll_style_ == CHARACTER ? char_width_pixels_ : 1;
+  return getStepRate() * 1000.0f * step_pixels;
+}
+
+void SignTextController::setScrollEasing(ScrollEasing easing, int ramp_ms) {
+  scroll_easing_ = easing;
+  scroll_ramp_ms_ = ramp_ms;
+  scroll_anchored_ = false;
+}
+
+void SignTextController::setSubpixelScroll(bool enabled) {
+  subpixel_scroll_ = enabled;
+  scroll_fraction_ = 0;
+  scroll_anchored_ = false;  // Origin is kept in different units
+  frame_valid_ = false;
+}
+
+void SignTextController::setLoopGap(int blank_characters) {
+  loop_gap_chars_ = blank_characters;
+  if (scroll_style_ == LOOP) {
+    invalidateWindow();
+  }
 }
 
 void SignTextController::setCharacterSpacing(int spacing_pixels) {
   char_spacing_pixels_ = spacing_pixels;
+  invalidateStrip();
 }
 
 void SignTextController::setBrightness(uint8_t default_brightness) {
   default_brightness_ = default_brightness;
+  invalidateAttributes();
+}
+
+void SignTextController::setStyleRule(TextStyleRule* rule) {
+  style_rule_ = rule;
+  invalidateAttributes();
 }
 
 void SignTextController::setMessage(String message) {
   message_ = message;
+  message_source_.set(message_.c_str(), message_.length());
+  source_ = &message_source_;
+  invalidateWindow();
   resetScroll();
 }
 
@@ -63,23 +163,133 @@ String SignTextController::getMessage() const {
   return message_;
 }
 
+void SignTextController::setSource(TextSource* source) {
+  message_ = "";  // Release the old message's heap block
+  message_source_.set(nullptr, 0);
+  source_ = source;
+  invalidateWindow();
+  resetScroll();
+}
+
+uint32_t SignTextController::getMessageLength() const {
+  return source_ ? source_->length() : 0;
+}
+
+void SignTextController::setLiveCapacity(int characters) {
+  live_capacity_ = characters;
+  if (live_source_ && source_ != live_source_) {
+    delete live_source_;  // Reallocated at the new size when next needed
+    live_source_ = nullptr;
+  }
+}
+
+void SignTextController::appendText(const char* text, int count) {
+  beginLiveText();
+  live_source_->append(text, count);
+  if (scroll_style_ == SMOOTH || scroll_style_ == CHARACTER) {
+    scroll_complete_ = false;  // There is more to scroll now
+  }
+  // The window picks the new text up as it comes into view (ensureWindow)
+}
+
+void SignTextController::appendText(const String& text) {
+  appendText(text.c_str(), text.length());
+}
+
+int SignTextController::replaceText(uint32_t position, const char* text, int count) {
+  beginLiveText();
+  int written = live_source_->replace(position, text, count);
+  if (written == 0) return 0;
+  
+  if (scroll_style_ == LOOP) {
+    invalidateWindow();  // The window holds the text more than once
+    return written;
+  }
+  
+  // Patch the window copy in place; only the changed glyphs are rasterized
+  // again, the rest of the strip is just recolored
+  uint32_t start = max(position, live_source_->firstAvailable());  // Dropped text is clipped off the front
+  uint32_t first = max(start, window_start_);
+  uint32_t last = min(start + written, window_start_ + window_count_);
+  if (window_valid_ && first < last) {
+    memcpy(window_text_ + (first - window_start_), text + (first - position), last - first);
+    int first_index = first - window_start_;
+    int last_index = min((int)(last - window_start_), strip_chars_);
+    if (display_manager_ && first_index < last_index) {
+      rasterizeChars(first_index, last_index);
+    }
+    invalidateAttributes();
+  }
+  return written;
+}
+
+int SignTextController::replaceText(uint32_t position, const String& text) {
+  return replaceText(position, text.c_str(), text.length());
+}
+
+void SignTextController::finishText() {
+  if (live_source_ && source_ == live_source_) {
+    live_source_->finish();
+  }
+}
+
+void SignTextController::beginLiveText() {
+  if (live_source_ && source_ == live_source_) return;
+  
+  // A setMessage() text carries over at the same positions, so the scroll,
+  // window and strip stay as they are. The ring holds all of it plus the
+  // usual capacity for appends - otherwise a long story would lose its
+  // unread head to the first append.
+  bool carry_over = source_ == &message_source_;
+  int capacity = carry_over ? message_.length() + live_capacity_ : live_capacity_;
+  if (live_source_ && live_source_->getCapacity() != capacity) {
+    delete live_source_;
+    live_source_ = nullptr;
+  }
+  if (live_source_) {
+    live_source_->clear();
+  } else {
+    live_source_ = new RingTextSource(capacity);
+  }
+  
+  if (carry_over) {
+    live_source_->append(message_.c_str(), message_.length());
+  }
+  source_ = live_source_;
+  message_ = "";
+  message_source_.set(nullptr, 0);
+  if (carry_over) {
+    invalidateAttributes();  // Legacy brightness callbacks now see only the window
+  } else {
+    invalidateWindow();
+    resetScroll();
+  }
+}
+
 void SignTextController::setScrollChars(int char_position) {
   scroll_char_position_ = char_position;
   scroll_pixel_offset_ = char_position * char_width_pixels_;
+  scroll_fraction_ = 0;
   scroll_complete_ = false;
+  scroll_anchored_ = false;
 }
 
-void SignTextController::setScrollPixels(int pixel_offset) {
+void SignTextController::setScrollPixels(int pixel_offset, uint8_t fraction) {
   scroll_pixel_offset_ = pixel_offset;
   scroll_char_position_ = pixel_offset / char_width_pixels_;
+  scroll_fraction_ = subpixel_scroll_ && display_manager_ ? fraction : 0;
   scroll_complete_ = false;
+  scroll_anchored_ = false;
 }
 
 void SignTextController::resetScroll() {
   scroll_char_position_ = 0;
   scroll_pixel_offset_ = 0;
+  scroll_fraction_ = 0;
   scroll_complete_ = false;
-  last_update_time_ = 0;
+  scroll_anchored_ = false;
+  skipped_steps_ = 0;
+  frame_valid_ = false;
 }
 
 void SignTextController::highlightText(int start_char, int end_char, uint8_t brightness) {
@@ -90,6 +300,7 @@ void SignTextController::highlightText(int start_char, int end_char, uint8_t bri
       highlights_[i].end_char = end_char;
       highlights_[i].brightness = brightness;
       highlights_[i].active = true;
+      invalidateAttributes();
       break;
     }
   }
@@ -99,22 +310,20 @@ void SignTextController::clearHighlights() {
   for (int i = 0; i < MAX_HIGHLIGHTS; i++) {
     highlights_[i].active = false;
   }
+  invalidateAttributes();
 }
 
 void SignTextController::update() {
-  if (message_.length() == 0) {
-    return;
+  if (getMessageLength() == 0) {
+    return;  // Nothing yet - a live source may still deliver text
   }
   
-  unsigned long current_time = millis();
-  
-  // Check if enough time has passed for update
-  if (current_time - last_update_time_ < scroll_speed_ms_) {
-    return;
+  // No interval gate: the scroll position follows the clock and a frame is
+  // only sent when it changes, so calling this often is cheap
+  if (scroll_style_ != LOOP) {
+    skipDroppedText();
   }
   
-  last_update_time_ = current_time;
-  
   switch (scroll_style_) {
     case SMOOTH:
       updateSmoothScroll();
@@ -125,6 +334,9 @@ void SignTextController::update() {
     case STATIC:
       updateStaticDisplay();
       break;
+    case LOOP:
+      updateLoopScroll();
+      break;
   }
 }
 
@@ -136,6 +348,38 @@ void SignTextController::reset() {
   resetScroll();
 }
 
+void SignTextController::redraw() {
+  frame_valid_ = false;
+  cells_valid_ = false;
+}
+
+void SignTextController::setRepeat(bool repeat) {
+  repeat_ = repeat;
+}
+
+uint32_t SignTextController::estimatedDurationMs() const {
+  float rate = getStepRate();
+  if (rate <= 0 || scroll_style_ == STATIC) {
+    return 0;
+  }
+  if (scroll_style_ == LOOP) {
+    return (uint32_t)((getMessageLength() + loop_gap_chars_) * getEffectiveCharWidth() / rate + 0.5f);
+  }
+  if (getMessageLength() <= (uint32_t)display_width_chars_) {
+    return 0;
+  }
+  
+  // update() completes once the clock reaches the last step, plus one
+  // ramp when easing (see easedDistance)
+  int steps = scroll_style_ == SMOOTH ? calculateTotalScrollPixels()
+                                      : getMessageLength() - display_width_chars_ + 1;
+  float duration = steps / rate;
+  if (scroll_easing_ == EASE_IN_OUT && scroll_ramp_ms_ > 0) {
+    duration += min((float)scroll_ramp_ms_, duration);
+  }
+  return (uint32_t)(duration + 0.5f);
+}
+
 int SignTextController::getCurrentCharPosition() const {
   return scroll_char_position_;
 }
@@ -145,7 +389,7 @@ int SignTextController::getCurrentPixelOffset() const {
 }
 
 bool SignTextController::isScrolling() const {
-  return !scroll_complete_ && (scroll_style_ == SMOOTH || scroll_style_ == CHARACTER);
+  return !scroll_complete_ && scroll_style_ != STATIC;
 }
 
 ScrollStyle SignTextController::getScrollStyle() const {
@@ -157,7 +401,7 @@ int SignTextController::calculateTotalScrollPixels() const {
   int effective_char_width = getEffectiveCharWidth();
   
   // Total message width in pixels (including spacing)
-  int total_message_pixels = message_.length() * effective_char_width;
+  int total_message_pixels = getMessageLength() * effective_char_width;
   
   // Display width in pixels
   int display_width_pixels = display_width_chars_ * effective_char_width;
@@ -170,7 +414,7 @@ int SignTextController::calculateTotalScrollPixels() const {
 int SignTextController::getEffectiveCharWidth() const {
   // For smooth scrolling, include spacing between characters
   // For character and static scrolling, use base character width
-  if (scroll_style_ == SMOOTH) {
+  if (scroll_style_ == SMOOTH || scroll_style_ == LOOP) {
     return char_width_pixels_ + char_spacing_pixels_;
   }
   return char_width_pixels_;
@@ -178,6 +422,14 @@ int SignTextController::getEffectiveCharWidth() const {
 
 void SignTextController::setDisplayManager(::DisplayManager* display_manager) {
   display_manager_ = display_manager;
+  invalidateStrip();
+  cells_valid_ = false;
+}
+
+void SignTextController::setViewport(int x, int y) {
+  viewport_x_ = x;
+  viewport_y_ = y;
+  redraw();
 }
 
 void SignTextController::setRenderCallback(RenderCallback callback) {
@@ -194,161 +446,635 @@ void SignTextController::setDrawCallback(DrawCallback callback) {
 
 void SignTextController::setBrightnessCallback(BrightnessCallback callback) {
   brightness_callback_ = callback;
+  invalidateAttributes();
 }
 
 void SignTextController::updateSmoothScroll() {
+  bool finished = isMessageFinished();
+  
   // Handle short messages that fit on screen
-  if (message_.length() <= display_width_chars_) {
+  if (finished && getMessageLength() <= (uint32_t)display_width_chars_) {
     updateStaticDisplay();
-    scroll_complete_ = true;
     return;
   }
   
-  // Calculate total scroll distance needed
+  // Calculate total scroll distance needed; a live source waits with the
+  // newest text at the right edge instead
   int total_scroll_pixels = calculateTotalScrollPixels();
+  int end = finished ? total_scroll_pixels : total_scroll_pixels - getEffectiveCharWidth();
   
-  // Check if scrolling is complete
-  if (scroll_pixel_offset_ >= total_scroll_pixels) {
-    scroll_complete_ = true;
+  // Sub-pixel scrolling runs the clock in 1/256 pixel units, 64-bit so a
+  // book-length message does not overflow past 8M pixels
+  int scale = subpixel_scroll_ && display_manager_ ? 256 : 1;
+  int64_t position = (int64_t)scroll_pixel_offset_ * scale + scroll_fraction_;
+  int64_t target = advanceScroll(position, (int64_t)end * scale, finished, scale);
+  if (finished && target >= (int64_t)total_scroll_pixels * scale) {
+    if (completeScroll(true)) {
+      updateSmoothScroll();  // First frame of the next pass, no idle frame
+    }
     return;
   }
   
-  // Render current frame
-  renderMessage();
-  
-  // Advance scroll position
-  scroll_pixel_offset_++;
+  scroll_pixel_offset_ = target / scale;
+  scroll_fraction_ = target % scale;
   scroll_char_position_ = scroll_pixel_offset_ / char_width_pixels_;
+  renderIfChanged();
 }
 
 void SignTextController::updateCharacterScroll() {
+  bool finished = isMessageFinished();
+  
   // Handle short messages that fit on screen
-  if (message_.length() <= display_width_chars_) {
+  if (finished && getMessageLength() <= (uint32_t)display_width_chars_) {
     updateStaticDisplay();
-    scroll_complete_ = true;
     return;
   }
   
-  // Calculate total character positions needed
-  int total_char_positions = message_.length() - display_width_chars_ + 1;
+  // Calculate total character positions needed; a live source waits with
+  // the newest text at the right edge instead
+  int total_char_positions = getMessageLength() - display_width_chars_ + 1;
+  int end = finished ? total_char_positions : total_char_positions - 1;
   
-  // Check if scrolling is complete
-  if (scroll_char_position_ >= total_char_positions) {
-    scroll_complete_ = true;
+  int target = (int)advanceScroll(scroll_char_position_, end, finished);
+  if (finished && target >= total_char_positions) {
+    if (completeScroll(true)) {
+      updateCharacterScroll();  // First frame of the next pass, no idle frame
+    }
     return;
   }
   
-  // Render current frame
-  renderMessage();
-  
-  // Advance character position
-  scroll_char_position_++;
+  scroll_char_position_ = target;
   scroll_pixel_offset_ = scroll_char_position_ * char_width_pixels_;
+  renderIfChanged();
 }
 
 void SignTextController::updateStaticDisplay() {
-  renderMessage();
+  renderIfChanged();
+  completeScroll(false);
+}
+
+void SignTextController::updateLoopScroll() {
+  // The message repeats as text + gap forever, so positions past the end
+  // are virtual: the window reads them wrapped (readLoop) and the scroll
+  // never completes
+  uint32_t length = getMessageLength();
+  if (length != loop_length_) {
+    loop_length_ = length;  // A live source grew - the period changed
+    invalidateWindow();
+  }
+  
+  int period_chars = length + loop_gap_chars_;
+  int scale = subpixel_scroll_ && display_manager_ ? 256 : 1;
+  int64_t period = (int64_t)period_chars * getEffectiveCharWidth() * scale;
+  int64_t position = (int64_t)scroll_pixel_offset_ * scale + scroll_fraction_;
+  int64_t target = advanceScroll(position, INT64_MAX, true, scale);
+  
+  if (target >= period) {
+    // One full pass: step back a period. The text there is identical, so
+    // the window and strip stay valid when they lie past the first pass.
+    target -= period;
+    if (window_start_ >= (uint32_t)period_chars) {
+      window_start_ -= period_chars;
+    } else {
+      window_valid_ = false;
+    }
+    if ((int64_t)rendered_offset_ * scale + rendered_fraction_ >= period) {
+      rendered_offset_ -= period / scale;  // Same frame, no redraw needed
+    }
+    
+    // Restart the clock at the wrapped position to keep the numbers small;
+    // the ease-in ramp only applies to the first pass
+    if (millis() - scroll_origin_time_ > (unsigned long)scroll_ramp_ms_ || !scroll_ramp_in_) {
+      scroll_origin_time_ = millis();
+      scroll_origin_step_ = target;
+      scroll_ramp_in_ = false;
+    } else {
+      scroll_origin_step_ -= period;
+    }
+    
+    if (on_wrap_) {
+      on_wrap_();
+    }
+  }
+  
+  scroll_pixel_offset_ = target / scale;
+  scroll_fraction_ = target % scale;
+  scroll_char_position_ = scroll_pixel_offset_ / char_width_pixels_;
+  renderIfChanged();
+}
+
+bool SignTextController::completeScroll(bool can_wrap) {
+  // Returns true when the scroll wrapped and should render its first frame
+  if (scroll_complete_) return false;
   scroll_complete_ = true;
+  if (on_complete_) {
+    on_complete_();
+  }
+  if (!can_wrap || !repeat_ || !scroll_complete_) {
+    return false;  // Also when the hook already reset or replaced the message
+  }
+  
+  resetScroll();
+  if (on_wrap_) {
+    on_wrap_();
+  }
+  return true;
+}
+
+int64_t SignTextController::advanceScroll(int64_t position, int64_t end, bool end_is_final, int scale) {
+  unsigned long now = millis();
+  if (!scroll_anchored_) {
+    // First frame after a reset, seek or speed change - show it as is
+    scroll_origin_time_ = now;
+    scroll_origin_step_ = position;
+    scroll_anchored_ = true;
+    scroll_ramp_in_ = true;
+    return position;
+  }
+  
+  int64_t target;
+  float rate = getStepRate();
+  if (rate <= 0) {
+    target = position + scale;  // Externally timed: one whole step per call
+  } else {
+    // Double keeps 1/256 pixel precision hours into a scroll
+    double total = end_is_final ? (double)(end - scroll_origin_step_) : -1.0;
+    target = scroll_origin_step_ + (int64_t)easedDistance(now - scroll_origin_time_, (double)rate * scale, total);
+  }
+  if (target > end) target = end;
+  if (target < position) target = position;
+  
+  if (!end_is_final && target == end) {
+    // Holding for live text - restart the clock so new text scrolls in
+    // from here rather than jumping by the time spent waiting
+    scroll_origin_time_ = now;
+    scroll_origin_step_ = end;
+  }
+  
+  if (target > position + scale) {
+    skipped_steps_ += (target - position) / scale - 1;
+  }
+  return target;
+}
+
+float SignTextController::getStepRate() const {
+  // Steps per millisecond; a step is a pixel in SMOOTH, a character in CHARACTER
+  if (scroll_velocity_ > 0) {
+    int step_pixels = scroll_style_ == CHARACTER ? char_width_pixels_ : 1;
+    return scroll_velocity_ / (1000.0f * step_pixels);
+  }
+  if (scroll_speed_ms_ > 0) {
+    return 1.0f / scroll_speed_ms_;
+  }
+  return 0;
+}
+
+double SignTextController::easedDistance(double elapsed_ms, double rate, double total) const {
+  if (scroll_easing_ == EASE_LINEAR || scroll_ramp_ms_ <= 0 || !scroll_ramp_in_) {
+    return elapsed_ms * rate;
+  }
+  
+  // Trapezoidal velocity: linear ramps of ramp_ms at each end (only the
+  // start when the end is not known yet), so the message takes exactly
+  // total / rate + ramp_ms
+  double ramp = scroll_ramp_ms_;
+  if (total >= 0) {
+    if (total < rate * ramp) ramp = total / rate;  // Too short to reach full speed
+    double duration = total / rate + ramp;
+    if (elapsed_ms >= duration) return total;
+    if (elapsed_ms > duration - ramp) {
+      double remaining = duration - elapsed_ms;
+      return total - rate * remaining * remaining / (2 * ramp);
+    }
+  }
+  if (elapsed_ms < ramp) {
+    return rate * elapsed_ms * elapsed_ms / (2 * ramp);
+  }
+  return rate * (elapsed_ms - ramp / 2);
+}
+
+void SignTextController::renderIfChanged() {
+  // Appended live text can change the frame without moving the scroll
+  uint32_t length = getMessageLength();
+  if (frame_valid_ && rendered_offset_ == scroll_pixel_offset_ &&
+      rendered_fraction_ == scroll_fraction_ && rendered_length_ == length) {
+    return;
+  }
+  uint32_t version = display_manager_ ? display_manager_->getBufferVersion() : 0;
+  renderMessage();
+  if (display_manager_) {
+    draw_count_ += display_manager_->getBufferVersion() - version;
+  }
+  frame_valid_ = true;
+  rendered_offset_ = scroll_pixel_offset_;
+  rendered_fraction_ = scroll_fraction_;
+  rendered_length_ = length;
 }
 
 void SignTextController::renderMessage() {
-  // Use DisplayManager if available, otherwise fall back to callbacks
+  // Only the characters under the display are touched, so a frame costs the
+  // same for a headline as for a book
+  uint32_t first_char = 0, last_char = 0;
+  bool any_visible = getVisibleRange(first_char, last_char);
+  if (any_visible) {
+    ensureWindow(first_char, last_char);
+  }
+  
+  if (display_manager_ && scroll_style_ == STATIC) {
+    renderStaticCells(any_visible, last_char);
+    return;
+  }
+  
   if (display_manager_) {
-    // Clear the display
-    display_manager_->clearBuffer();
-  } else if (!clear_callback_ || !render_callback_ || !draw_callback_) {
+    // Copy the visible window out of the pre-rasterized strip; columns past
+    // the end of the text are cleared by the blit
+    if (any_visible && !strip_valid_) {
+      rebuildStrip();
+    }
+    int first_pixel = scroll_style_ == STATIC ? 0 : scroll_pixel_offset_;
+    int first_column = any_visible ? first_pixel - (int)window_start_ * getEffectiveCharWidth() : 0;
+    int x = 0;
+    if (first_column < 0) {
+      // Window starts right of the display edge (dropped ring text) - blank the gap
+      x = -first_column;
+      first_column = 0;
+      display_manager_->blitColumns(nullptr, nullptr, 0, x, viewport_x_, viewport_y_, 6);
+    }
+    int available = any_visible ? strip_columns_ - first_column : 0;
+    if (available < 0) available = 0;
+    uint8_t fraction = scroll_style_ == CHARACTER ? 0 : scroll_fraction_;
+    display_manager_->blitColumns(strip_mask_ + first_column, strip_brightness_ + first_column,
+                                  available, display_width_pixels_ - x, viewport_x_ + x, viewport_y_, 6, fraction);
+    if (auto_present_) {
+      display_manager_->updateDisplay();
+    }
+    return;
+  }
+  
+  // Legacy callback path - render character by character
+  if (!clear_callback_ || !render_callback_ || !draw_callback_) {
     return; // Can't render without callbacks or DisplayManager
   } else {
     // Clear the display using callback
     clear_callback_();
   }
   
+  // Static frames start at pixel 0 with no spacing, scrolling frames at
+  // the scroll offset; either way only the visible range is drawn
+  int effective_char_width = getEffectiveCharWidth();
+  int first_pixel = scroll_style_ == STATIC ? 0 : scroll_pixel_offset_;
+  if (any_visible) {
+    for (uint32_t char_idx = first_char; char_idx <= last_char; char_idx++) {
+      int i = char_idx - window_start_;
+      uint8_t ascii = window_text_[i] - 32;
+      int char_pixel_pos = (char_idx * effective_char_width) - first_pixel;
+      render_callback_(ascii, char_pixel_pos, attributes_[i].brightness, current_font_ == MODERN_FONT);
+    }
+  }
+  
+  // Draw the rendered frame
+  draw_callback_();
+}
+
+void SignTextController::renderStaticCells(bool any_visible, uint32_t last_char) {
+  // A clock line changes a digit or two per update - compare each cell with
+  // what it last showed and draw only the ones that differ. If anything else
+  // drew on the display since, every cell is drawn again - on a shared
+  // display the owner calls redraw() instead, as the other zones move the
+  // buffer version every frame.
+  if (!shared_display_ && display_manager_->getBufferVersion() != cells_version_) {
+    cells_valid_ = false;
+  }
+  
+  // Rows are 4 bits wide; shift them to the cell width so the cell's
+  // spacing columns are cleared too
+  int width = min(char_width_pixels_, 8);
+  bool changed = false;
+  for (int cell = 0; cell < display_width_chars_; cell++) {
+    char c = ' ';
+    uint8_t brightness = 0;
+    if (any_visible && (uint32_t)cell >= window_start_ && (uint32_t)cell <= last_char) {
+      int i = cell - window_start_;
+      c = window_text_[i];
+      brightness = attributes_[i].brightness;
+    }
+    if (cells_valid_ && cell_text_[cell] == c && cell_brightness_[cell] == brightness) {
+      continue;
+    }
+    cell_text_[cell] = c;
+    cell_brightness_[cell] = brightness;
+    
+    uint8_t glyph[6];
+    display_manager_->getGlyph(c - 32, glyph, current_font_ == MODERN_FONT);
+    for (int row = 0; row < 6; row++) {
+      glyph[row] = width >= 4 ? glyph[row] << (width - 4) : glyph[row] >> (4 - width);
+    }
+    display_manager_->blitGlyph(glyph, 6, width, viewport_x_ + cell * char_width_pixels_, viewport_y_, brightness, 0);
+    changed = true;
+  }
+  
+  if (changed && auto_present_) {
+    display_manager_->updateDisplay();  // Only boards with changed pixels are sent
+  }
+  cells_valid_ = true;
+  cells_version_ = display_manager_->getBufferVersion();
+}
+
+bool SignTextController::getVisibleRange(uint32_t& first_char, uint32_t& last_char) const {
+  uint32_t length = getMessageLength();
+  if (length == 0) return false;
+  
   if (scroll_style_ == STATIC) {
-    // Static display - show first characters that fit
-    for (int i = 0; i < min((int)message_.length(), display_width_chars_); i++) {
-      char c = message_.charAt(i);
-      uint8_t ascii = c - 32;
-      uint8_t brightness = getCharacterBrightness(c, i);
-      int pixel_pos = i * char_width_pixels_;
-      
-      if (display_manager_) {
-        // Get character pattern and draw using DisplayManager
-        uint8_t pattern[6];
-        for (int row = 0; row < 6; row++) {
-          pattern[row] = display_manager_->getCharacterPattern(ascii, row, current_font_ == MODERN_FONT);
-        }
-        display_manager_->drawCharacter(pattern, pixel_pos, brightness);
-      } else if (render_callback_) {
-        render_callback_(ascii, pixel_pos, brightness, current_font_ == MODERN_FONT);
-      }
+    // Whole characters from the start, as many as fit
+    first_char = 0;
+    last_char = min(length, (uint32_t)display_width_chars_) - 1;
+    return true;
+  }
+  
+  // A character is visible while any of its glyph columns is on screen:
+  // char * w - offset > -char_width and char * w - offset < display width
+  int effective_char_width = getEffectiveCharWidth();
+  int hidden = scroll_pixel_offset_ - char_width_pixels_;
+  first_char = hidden < 0 ? 0 : hidden / effective_char_width + 1;
+  // Part way between pixels, the last column blends in one more from the right
+  int last_pixel = scroll_pixel_offset_ + display_width_pixels_ - (scroll_fraction_ ? 0 : 1);
+  last_char = last_pixel / effective_char_width;
+  if (scroll_style_ != LOOP && last_char >= length) last_char = length - 1;  // LOOP text never ends
+  return first_char <= last_char;
+}
+
+void SignTextController::ensureWindow(uint32_t first_char, uint32_t last_char) {
+  uint32_t window_end = window_start_ + window_count_;
+  bool covered = window_valid_ && first_char >= window_start_ && last_char < window_end;
+  bool extends = window_valid_ && scroll_style_ != LOOP && source_ && first_char >= window_start_ &&
+                 last_char + WINDOW_READ_AHEAD / 2 < window_start_ + window_capacity_ &&
+                 window_end >= source_->firstAvailable();
+  if (!covered && extends) {
+    // Appended text came into view and still fits with some read-ahead -
+    // read just the new characters; the strip keeps the ones it already
+    // rasterized
+    window_count_ += source_->read(window_end, window_text_ + window_count_, window_capacity_ - window_count_);
+    trimPartialWord(last_char);
+    attributes_valid_ = false;
+    strip_valid_ = false;
+  } else if (!covered) {
+    // Refill with some history behind the visible start and read-ahead
+    // past the end
+    uint32_t start = first_char > (uint32_t)WINDOW_HISTORY ? first_char - WINDOW_HISTORY : 0;
+    if (source_ && scroll_style_ != LOOP && start < source_->firstAvailable()) {
+      start = source_->firstAvailable();
     }
-  } else {
-    // Scrolling display - render visible characters
-    int effective_char_width = getEffectiveCharWidth();
-    for (int char_idx = 0; char_idx < message_.length(); char_idx++) {
-      char c = message_.charAt(char_idx);
-      uint8_t ascii = c - 32;
-      int char_pixel_pos = (char_idx * effective_char_width) - scroll_pixel_offset_;
-      
-      // Only render characters that are at least partially visible
-      if (shouldCharacterBeVisible(char_idx, char_pixel_pos)) {
-        uint8_t brightness = getCharacterBrightness(c, char_idx);
-        
-        if (display_manager_) {
-          // Get character pattern and draw using DisplayManager
-          uint8_t pattern[6];
-          for (int row = 0; row < 6; row++) {
-            pattern[row] = display_manager_->getCharacterPattern(ascii, row, current_font_ == MODERN_FONT);
-          }
-          display_manager_->drawCharacter(pattern, char_pixel_pos, brightness);
-        } else if (render_callback_) {
-          render_callback_(ascii, char_pixel_pos, brightness, current_font_ == MODERN_FONT);
-        }
-      }
+    window_start_ = start;
+    window_count_ = readWindow(start, window_text_, window_capacity_);
+    
+    // Start at the space before the first visible word, so style rules
+    // never see the tail of a word cut off by the window start
+    int history = first_char > start ? first_char - start : 0;
+    int boundary = 0;
+    while (start > 0 && boundary < history && window_text_[boundary] != ' ') boundary++;
+    if (start > 0 && boundary > 0 && boundary < history) {
+      window_count_ -= boundary;
+      memmove(window_text_, window_text_ + boundary, window_count_);
+      window_start_ += boundary;
+      window_count_ += readWindow(window_start_ + window_count_, window_text_ + window_count_,
+                                  window_capacity_ - window_count_);
     }
+    trimPartialWord(last_char);
+    window_valid_ = true;
+    attributes_valid_ = false;
+    strip_valid_ = false;
+    strip_chars_ = 0;
   }
   
-  // Draw the rendered frame
-  if (display_manager_) {
-    display_manager_->updateDisplay();
-  } else if (draw_callback_) {
-    draw_callback_();
+  if (!attributes_valid_) {
+    computeAttributes();
   }
 }
 
-uint8_t SignTextController::getCharacterBrightness(char c, int char_index) {
-  // Check for highlights first
-  uint8_t highlight_brightness;
-  if (isCharacterHighlighted(char_index, highlight_brightness)) {
-    return highlight_brightness;
+int SignTextController::readWindow(uint32_t position, char* out, int count) {
+  if (scroll_style_ == LOOP) return readLoop(position, out, count);
+  return source_ ? source_->read(position, out, count) : 0;
+}
+
+void SignTextController::trimPartialWord(uint32_t last_char) {
+  // Drop a word cut off by the window end unless part of it is visible -
+  // it is read whole when it scrolls closer. The end of the text is a
+  // boundary (LOOP text never ends).
+  if (scroll_style_ != LOOP && window_start_ + window_count_ >= getMessageLength()) return;
+  int keep = window_count_;
+  while (keep > 0 && window_text_[keep - 1] != ' ') keep--;
+  if (keep == window_count_ || window_start_ + keep <= last_char) return;
+  window_count_ = keep;
+  if (strip_chars_ > window_count_) strip_chars_ = window_count_;
+}
+
+int SignTextController::readLoop(uint32_t position, char* out, int count) {
+  // Read the endless text + gap + text ... sequence in runs; text a ring
+  // source has already dropped reads as blanks
+  uint32_t length = getMessageLength();
+  uint32_t period = length + loop_gap_chars_;
+  int copied = 0;
+  while (copied < count) {
+    uint32_t source_position = (position + copied) % period;
+    int run;
+    if (source_position < length) {
+      run = min((uint32_t)(count - copied), length - source_position);
+      int got = source_->read(source_position, out + copied, run);
+      for (int i = got; i < run; i++) out[copied + i] = ' ';
+    } else {
+      run = min((uint32_t)(count - copied), period - source_position);
+      for (int i = 0; i < run; i++) out[copied + i] = ' ';
+    }
+    copied += run;
   }
+  return copied;
+}
+
+bool SignTextController::loopSourcePosition(uint32_t position, uint32_t& source_position) const {
+  // False inside the gap
+  uint32_t length = getMessageLength();
+  source_position = position % (length + loop_gap_chars_);
+  return source_position < length;
+}
+
+void SignTextController::skipDroppedText() {
+  // A ring source may have dropped text we have not shown yet - jump to the
+  // oldest character it still has rather than stall
+  if (!source_) return;
+  uint32_t oldest = source_->firstAvailable();
+  if (oldest == 0) return;
   
-  // Use custom brightness callback if available
-  if (brightness_callback_) {
-    return brightness_callback_(c, message_, char_index, false);
+  int effective_char_width = getEffectiveCharWidth();
+  if ((uint32_t)scroll_pixel_offset_ < oldest * effective_char_width) {
+    scroll_pixel_offset_ = oldest * effective_char_width;
+    scroll_fraction_ = 0;
+    scroll_char_position_ = scroll_style_ == CHARACTER ? oldest : scroll_pixel_offset_ / char_width_pixels_;
+    scroll_anchored_ = false;
+  }
+}
+
+bool SignTextController::isMessageFinished() const {
+  return !source_ || source_->isFinished();
+}
+
+void SignTextController::rebuildStrip() {
+  // Sized for a full window once, so growing the window keeps the glyphs
+  int effective_char_width = getEffectiveCharWidth();
+  int capacity = window_capacity_ * effective_char_width;
+  if (capacity > strip_capacity_) {
+    delete[] strip_mask_;
+    delete[] strip_brightness_;
+    strip_mask_ = new uint8_t[capacity];
+    strip_brightness_ = new uint8_t[capacity];
+    strip_capacity_ = capacity;
+    strip_chars_ = 0;
   }
   
-  // Default brightness
-  return default_brightness_;
+  // Rasterize only characters new to the window, then color every column
+  if (strip_chars_ < window_count_) {
+    rasterizeChars(strip_chars_, window_count_);
+  }
+  strip_chars_ = window_count_;
+  strip_columns_ = window_count_ * effective_char_width;
+  
+  for (int i = 0; i < window_count_; i++) {
+    uint8_t brightness = attributes_[i].brightness;
+    int base = i * effective_char_width;
+    for (int col = 0; col < effective_char_width; col++) {
+      strip_brightness_[base + col] = strip_mask_[base + col] ? brightness : 0;
+    }
+  }
+  strip_valid_ = true;
 }
 
-bool SignTextController::isCharacterHighlighted(int char_index, uint8_t& highlight_brightness) {
-  for (int i = 0; i < MAX_HIGHLIGHTS; i++) {
-    if (highlights_[i].active && 
-        char_index >= highlights_[i].start_char && 
-        char_index <= highlights_[i].end_char) {
-      highlight_brightness = highlights_[i].brightness;
-      return true;
+void SignTextController::rasterizeChars(int first, int last) {
+  // Font rows are 4 bits wide, bit 3 leftmost; turn them into column masks
+  int effective_char_width = getEffectiveCharWidth();
+  for (int i = first; i < last; i++) {
+    uint8_t glyph[6];
+    display_manager_->getGlyph(window_text_[i] - 32, glyph, current_font_ == MODERN_FONT);
+    
+    int base = i * effective_char_width;
+    for (int col = 0; col < effective_char_width; col++) {
+      uint8_t mask = 0;
+      if (col < char_width_pixels_ && col < 4) {
+        for (int row = 0; row < 6; row++) {
+          mask |= ((glyph[row] >> (3 - col)) & 1) << row;
+        }
+      }
+      strip_mask_[base + col] = mask;
     }
   }
-  return false;
 }
 
+void SignTextController::computeAttributes() {
+  for (int i = 0; i < window_count_; i++) {
+    attributes_[i].brightness = default_brightness_;
+    attributes_[i].flags = 0;
+  }
+  
+  // One pass over the window for the rule (or the legacy callback)
+  if (style_rule_) {
+    uint32_t length = getMessageLength();
+    if (scroll_style_ != LOOP) {
+      style_rule_->apply(window_text_, window_count_, window_start_, length, attributes_);
+    } else {
+      // The window repeats the text - one call per repetition, none for the gap
+      int i = 0;
+      while (i < window_count_) {
+        uint32_t position;
+        bool in_text = loopSourcePosition(window_start_ + i, position);
+        uint32_t run_end = in_text ? length : length + loop_gap_chars_;
+        int run = min((uint32_t)(window_count_ - i), run_end - position);
+        if (in_text) {
+          style_rule_->apply(window_text_ + i, run, position, length, attributes_ + i);
+        }
+        i += run;
+      }
+    }
+  } else if (brightness_callback_) {
+    // Callbacks expect the whole message; streamed sources only have the window
+    bool whole_message = source_ == &message_source_ && scroll_style_ != LOOP;
+    String text = whole_message ? message_ : String();
+    if (!whole_message) {
+      text.reserve(window_count_);
+      for (int i = 0; i < window_count_; i++) text += window_text_[i];
+    }
+    for (int i = 0; i < window_count_; i++) {
+      int position = whole_message ? window_start_ + i : i;
+      attributes_[i].brightness = brightness_callback_(window_text_[i], text, position, false);
+    }
+  }
+  
+  // Highlights (absolute character positions) override the rule; the first
+  // matching span wins
+  int window_end = window_start_ + window_count_;
+  for (int h = MAX_HIGHLIGHTS - 1; h >= 0; h--) {
+    if (!highlights_[h].active) continue;
+    if (scroll_style_ == LOOP) {
+      // The window repeats the text - map every character back to it
+      for (int i = 0; i < window_count_; i++) {
+        uint32_t position;
+        if (loopSourcePosition(window_start_ + i, position) &&
+            (int)position >= highlights_[h].start_char && (int)position <= highlights_[h].end_char) {
+          attributes_[i].brightness = highlights_[h].brightness;
+        }
+      }
+      continue;
+    }
+    int first = max(highlights_[h].start_char, (int)window_start_);
+    int last = min(highlights_[h].end_char, window_end - 1);
+    for (int i = first; i <= last; i++) {
+      attributes_[i - window_start_].brightness = highlights_[h].brightness;
+    }
+  }
+  
+  attributes_valid_ = true;
+  strip_valid_ = false;
+}
 
+void CapitalizedWordRule::apply(const char* text, int length, uint32_t, uint32_t,
+                                CharAttributes* attributes) {
+  int word_start = 0;
+  while (word_start < length) {
+    // Classify the whole word once, then style all of its characters
+    int word_end = word_start;
+    bool has_capitals = false;
+    bool has_lowercase = false;
+    while (word_end < length && text[word_end] != ' ') {
+      char c = text[word_end];
+      if (c >= 'A' && c <= 'Z') has_capitals = true;
+      else if (c >= 'a' && c <= 'z') has_lowercase = true;
+      word_end++;
+    }
+    
+    bool capitalized = has_capitals && !has_lowercase;
+    for (int i = word_start; i < word_end; i++) {
+      char c = text[i];
+      if (capitalized) {
+        attributes[i].brightness = capitalized_;
+      } else if (c >= '0' && c <= '9') {
+        attributes[i].brightness = digits_;
+      } else {
+        attributes[i].brightness = other_;
+      }
+    }
+    
+    // The space itself belongs to no word
+    if (word_end < length) {
+      attributes[word_end].brightness = other_;
+    }
+    word_start = word_end + 1;
+  }
+}
 
-bool SignTextController::shouldCharacterBeVisible(int char_index, int char_pixel_pos) const {
-  // Character is visible if any part of it is on screen
-  return char_pixel_pos > -char_width_pixels_ && char_pixel_pos < display_width_pixels_;
+void TrailingSpanRule::apply(const char*, int length, uint32_t start, uint32_t message_length,
+                             CharAttributes* attributes) {
+  // The span is the end of the message, wherever this run lies in it
+  uint32_t span_start = message_length > (uint32_t)span_length_ ? message_length - span_length_ : 0;
+  for (int i = 0; i < length; i++) {
+    attributes[i].brightness = start + i >= span_start ? span_brightness_ : rest_brightness_;
+  }
 }
 
 } // namespace RetroText
@@ -0,0 +1,34 @@
+#include "Tca9548aMux.h"
+
+Tca9548aMux::Tca9548aMux(I2CBus* bus, uint8_t address)
+  : bus_(bus)
+  , address_(address)
+  , channel_(NO_CHANNEL)
+  , known_(false)
+{
+}
+
+bool Tca9548aMux::select(uint8_t channel) {
+  if (channel >= CHANNEL_COUNT) return false;
+  if (known_ && channel_ == channel) return true;
+
+  if (!bus_->writeByte(address_, 1 << channel)) {
+    invalidate();
+    return false;
+  }
+  channel_ = channel;
+  known_ = true;
+  return true;
+}
+
+bool Tca9548aMux::disableAll() {
+  if (known_ && channel_ == NO_CHANNEL) return true;
+
+  if (!bus_->writeByte(address_, 0x00)) {
+    invalidate();
+    return false;
+  }
+  channel_ = NO_CHANNEL;
+  known_ = true;
+  return true;
+}
@@ -0,0 +1,91 @@
+#include "TextSource.h"
+#include <string.h>
+
+MemoryTextSource::MemoryTextSource(const char* text)
+  : text_(text)
+  , length_(text ? strlen(text) : 0)
+{
+}
+
+int MemoryTextSource::read(uint32_t position, char* out, int count) {
+  if (position >= length_ || count <= 0) return 0;
+  uint32_t remaining = length_ - position;
+  if ((uint32_t)count > remaining) count = remaining;
+  memcpy(out, text_ + position, count);
+  return count;
+}
+
+RingTextSource::RingTextSource(int capacity)
+  : buffer_(new char[capacity])
+  , capacity_(capacity)
+  , end_(0)
+  , finished_(false)
+{
+}
+
+RingTextSource::~RingTextSource() {
+  delete[] buffer_;
+}
+
+int RingTextSource::append(const char* text, int count) {
+  uint32_t oldest_before = firstAvailable();
+
+  // Only the newest `capacity_` characters can survive the append
+  if (count > capacity_) {
+    end_ += count - capacity_;
+    text += count - capacity_;
+    count = capacity_;
+  }
+
+  int offset = end_ % capacity_;
+  int first_part = capacity_ - offset;
+  if (first_part > count) first_part = count;
+  memcpy(buffer_ + offset, text, first_part);
+  memcpy(buffer_, text + first_part, count - first_part);
+  end_ += count;
+
+  return firstAvailable() - oldest_before;
+}
+
+int RingTextSource::append(const char* text) {
+  return append(text, strlen(text));
+}
+
+int RingTextSource::replace(uint32_t position, const char* text, int count) {
+  // Clip to what the buffer still holds
+  uint32_t oldest = firstAvailable();
+  if (position < oldest) {
+    uint32_t skip = oldest - position;
+    if (skip >= (uint32_t)count) return 0;
+    text += skip;
+    count -= skip;
+    position = oldest;
+  }
+  if (position >= end_ || count <= 0) return 0;
+  if ((uint32_t)count > end_ - position) count = end_ - position;
+
+  int offset = position % capacity_;
+  int first_part = capacity_ - offset;
+  if (first_part > count) first_part = count;
+  memcpy(buffer_ + offset, text, first_part);
+  memcpy(buffer_, text + first_part, count - first_part);
+  return count;
+}
+
+void RingTextSource::clear() {
+  end_ = 0;
+  finished_ = false;
+}
+
+int RingTextSource::read(uint32_t position, char* out, int count) {
+  if (position < firstAvailable() || position >= end_ || count <= 0) return 0;
+  uint32_t remaining = end_ - position;
+  if ((uint32_t)count > remaining) count = remaining;
+
+  int offset = position % capacity_;
+  int first_part = capacity_ - offset;
+  if (first_part > count) first_part = count;
+  memcpy(out, buffer_ + offset, first_part);
+  memcpy(out + first_part, buffer_, count - first_part);
+  return count;
+}
@@ -0,0 +1,32 @@
+#include "WireBus.h"
+
+bool WireBus::writeRegisters(uint8_t address, uint8_t start_register, const uint8_t* data, int length) {
+  wire_->beginTransmission(address);
+  wire_->write(start_register);
+  wire_->write(data, length);
+  return wire_->endTransmission() == 0;
+}
+
+bool WireBus::writeByte(uint8_t address, uint8_t value) {
+  wire_->beginTransmission(address);
+  wire_->write(value);
+  return wire_->endTransmission() == 0;
+}
+
+bool WireBus::probe(uint8_t address) {
+  return probeError(address) == 0;
+}
+
+uint8_t WireBus::probeError(uint8_t address) {
+  wire_->beginTransmission(address);
+  return wire_->endTransmission();
+}
+
+int WireBus::maxWriteLength() const {
+  // Register byte shares the Wire transmit buffer with the data
+#ifdef I2C_BUFFER_LENGTH
+  return I2C_BUFFER_LENGTH - 1;
+#else
+  return 31;
+#endif
+}
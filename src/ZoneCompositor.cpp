@@ -0,0 +1,92 @@
+#include "ZoneCompositor.h"
+#include "DisplayManager.h"
+
+namespace RetroText {
+
+static const int ZONE_HEIGHT = 6;  // Controllers draw one text row
+
+ZoneCompositor::ZoneCompositor(::DisplayManager* display_manager)
+  : display_manager_(display_manager)
+  , zone_count_(0)
+  , seen_version_(0)
+  , seen_zone_draws_(0)
+{
+}
+
+bool ZoneCompositor::addZone(SignTextController* controller, int x, int y, uint32_t interval_ms) {
+  if (zone_count_ >= MAX_ZONES) return false;
+  
+  ZoneRect region = { x, y, controller->getViewportWidth(), ZONE_HEIGHT };
+  if (!ZoneGeometry::fits(region, display_manager_->getWidth(), display_manager_->getHeight())) {
+    Serial.printf("addZone: %dx%d at (%d, %d) is not on the %dx%d display\n", region.width, region.height,
+                  x, y, display_manager_->getWidth(), display_manager_->getHeight());
+    return false;
+  }
+  if (ZoneGeometry::findOverlap(region, regions_, zone_count_) >= 0) return false;
+  
+  regions_[zone_count_] = region;
+  Zone& zone = zones_[zone_count_++];
+  zone.controller = controller;
+  zone.interval_ms = interval_ms;
+  zone.last_update = millis() - interval_ms;  // Due on the first update()
+  
+  controller->setDisplayManager(display_manager_);
+  controller->setViewport(x, y);
+  controller->setAutoPresent(false);
+  controller->setSharedDisplay(true);
+  return true;
+}
+
+void ZoneCompositor::removeZone(SignTextController* controller) {
+  for (int i = 0; i < zone_count_; i++) {
+    if (zones_[i].controller != controller) continue;
+    controller->setAutoPresent(true);
+    controller->setSharedDisplay(false);
+    for (int j = i + 1; j < zone_count_; j++) {
+      zones_[j - 1] = zones_[j];
+      regions_[j - 1] = regions_[j];
+    }
+    zone_count_--;
+    return;
+  }
+}
+
+void ZoneCompositor::update() {
+  // The zones skip unchanged STATIC cells, trusting nothing else drew over
+  // them. Redraw them all if the buffer moved by more than their own draws.
+  uint32_t version = display_manager_->getBufferVersion();
+  uint32_t zone_draws = zoneDrawCount();
+  if (version - seen_version_ != zone_draws - seen_zone_draws_) {
+    redraw();
+  }
+  
+  unsigned long now = millis();
+  for (int i = 0; i < zone_count_; i++) {
+    Zone& zone = zones_[i];
+    if (now - zone.last_update < zone.interval_ms) continue;
+    zone.last_update = now;
+    zone.controller->update();
+  }
+  
+  // One flush for all zones; nothing is sent when no zone drew a change
+  display_manager_->present();
+  seen_version_ = display_manager_->getBufferVersion();
+  seen_zone_draws_ = zoneDrawCount();
+}
+
+void ZoneCompositor::redraw() {
+  for (int i = 0; i < zone_count_; i++) {
+    zones_[i].controller->redraw();
+    zones_[i].last_update = millis() - zones_[i].interval_ms;
+  }
+}
+
+uint32_t ZoneCompositor::zoneDrawCount() const {
+  uint32_t total = 0;
+  for (int i = 0; i < zone_count_; i++) {
+    total += zones_[i].controller->getDrawCount();
+  }
+  return total;
+}
+
+} // namespace RetroText
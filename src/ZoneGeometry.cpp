@@ -0,0 +1,18 @@
+#include "ZoneGeometry.h"
+
+bool ZoneGeometry::overlaps(const ZoneRect& a, const ZoneRect& b) {
+  return a.x < b.x + b.width && b.x < a.x + a.width &&
+         a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+bool ZoneGeometry::fits(const ZoneRect& zone, int display_width, int display_height) {
+  return zone.width > 0 && zone.height > 0 && zone.x >= 0 && zone.y >= 0 &&
+         zone.x + zone.width <= display_width && zone.y + zone.height <= display_height;
+}
+
+int ZoneGeometry::findOverlap(const ZoneRect& zone, const ZoneRect* zones, int count) {
+  for (int i = 0; i < count; i++) {
+    if (overlaps(zone, zones[i])) return i;
+  }
+  return -1;
+}
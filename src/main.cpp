@@ -10,25 +10,29 @@
 #include <WiFi.h>
 #include <WiFiManager.h>
 #include "SignTextController.h"
+#include "MessageQueue.h"
 #include "messages.h"
 #include "DisplayManager.h"
 #include "ClockDisplay.h"
 #include "MeteorAnimation.h"
+#include "EffectRegistry.h"
+#include "CellularEffects.h"
+#include "ShaderEffect.h"
 
 // Alternative font system
 #define FONT_WIDTH 4
 #define FONT_HEIGHT 6  // Back to 6 rows with adaptive character shifting
 
-// Mode system - four modes: AltFont, BasicFont, Clock, Animation
+// Mode system - AltFont, BasicFont, Clock, then one mode per registered effect
 enum DisplayMode {
   MODE_ALT_FONT = 0,    // Alternative font, smooth scrolling
   MODE_MIN_FONT = 1,    // Basic font, non-smooth scrolling  
   MODE_CLOCK = 2,       // Clock display with time/date
-  MODE_ANIMATION = 3    // Meteor animation with parallax stars
+  MODE_EFFECTS = 3      // First effect in the registry (meteors, ...)
 };
-const char* mode_names[] = {"AltFont", "BasicFont", "Clock", "Animation"};
+const char* mode_names[] = {"AltFont", "BasicFont", "Clock"};
 
-DisplayMode current_mode = MODE_ALT_FONT;
+int current_mode = MODE_ALT_FONT;
 bool demo_mode_enabled = true;  // Start in demo mode
 bool user_mode_enabled = false; // User-controlled mode
 unsigned long last_mode_change = 0;  // Track when mode was last changed
@@ -53,6 +57,7 @@ WifiTimeLib wifiTimeLib(NTP_SERVER, TZ_INFO);
 DisplayManager* display_manager = nullptr;
 ClockDisplay* clock_display = nullptr;
 MeteorAnimation* meteor_animation = nullptr;
+EffectRegistry* effects = nullptr;  // Ambient effects, one display mode each
 
 // Forward declarations
 void configModeCallback(WiFiManager *myWiFiManager);
@@ -84,15 +89,27 @@ int last_hour=0;
 
 // Display configuration - will be managed by DisplayManager
 #define NUM_BOARDS 3
+#define BOARD_ROWS 1   // Boards are tiled NUM_BOARDS / BOARD_ROWS wide
+static_assert(NUM_BOARDS % BOARD_ROWS == 0, "NUM_BOARDS must fill BOARD_ROWS rows evenly");
 #define WIDTH 24
 #define HEIGHT 6
 
+// TCA9548A mux on the main bus (e.g. 0x70) for more than 4 boards:
+// boards 0-3 on channel 0, 4-7 on channel 1, ... (0 = no mux)
+#define I2C_MUX_ADDRESS 0
+
+// Optional second I2C controller: set pins to move boards 1-2 onto Wire1 so
+// both halves of the chain are flushed in parallel (-1 keeps one bus)
+#define I2C_BUS1_SDA -1
+#define I2C_BUS1_SCL -1
+
 #define DRIVER_DEFAULT_BRIGHTNESS 90
 #define TEXT_BRIGHT 190        // For time, capitalized words
 #define TEXT_DEFAULT_BRIGHTNESS 90  // For normal text
 #define TEXT_DIM 30            // For regular lowercase text
 #define TEXT_VERY_DIM 12       // For background elements
 #define DEMO_MODE_INTERVAL 30000  // 30 seconds between auto mode changes
+#define LOOP_FRAME_MS 8        // Loop pacing: ~125 fps when a pass is cheap
 
 // IS31FL373x driver - no namespace needed
 
@@ -127,51 +144,9 @@ int last_hour=0;
 
 // Legacy character drawing functions removed - now handled by SignTextController and DisplayManager
 
-// Check if a word starting at position is all capitals
-bool is_word_capitalized(String text, int start_pos) {
-  int pos = start_pos;
-  bool has_letters = false;
-  
-  // Check characters until space or end of string
-  while (pos < text.length() && text.charAt(pos) != ' ') {
-    char c = text.charAt(pos);
-    if (c >= 'A' && c <= 'Z') {
-      has_letters = true;  // Found at least one capital letter
-    } else if (c >= 'a' && c <= 'z') {
-      return false;  // Found lowercase letter, word is not all caps
-    }
-    pos++;
-  }
-  
-  return has_letters;  // Word is capitalized if it has letters and no lowercase
-}
-
-// Determine brightness level based on character and context
-uint8_t get_character_brightness(char c, String text, int char_pos, bool is_time_display = false) {
-  if (is_time_display) {
-    // Time display: bright for time (last 8 characters), dim for date
-    int time_start_pos = text.length() - 8;  // Time starts at position for "12:43:25"
-    if (char_pos >= time_start_pos) {
-      return TEXT_BRIGHT;  // Time portion is bright
-    }
-    return TEXT_DIM;  // Date portion is dim
-  }
-  
-  // Find the start of the current word
-  int word_start = char_pos;
-  while (word_start > 0 && text.charAt(word_start - 1) != ' ') {
-    word_start--;
-  }
-  
-  // Check if the entire word is capitalized
-  if (is_word_capitalized(text, word_start)) {
-    return TEXT_BRIGHT;  // Entire capitalized word is bright
-  }
-  
-  // Regular character brightness
-  if (c >= '0' && c <= '9') return TEXT_DEFAULT_BRIGHTNESS; // Numbers normal
-  return TEXT_DIM;                                     // Everything else dim
-}
+// Capitalized words bright, numbers normal, everything else dim - applied
+// once per message by SignTextController
+RetroText::CapitalizedWordRule headline_style(TEXT_BRIGHT, TEXT_DEFAULT_BRIGHTNESS, TEXT_DIM);
 
 // write_character_at_offset removed - functionality replaced by SignTextController
 
@@ -185,14 +160,25 @@ uint8_t get_character_brightness(char c, String text, int char_pos, bool is_time
 int current_message_index = 0;
 String current_message = "";  // Will be initialized in setup
 
-// Module announcement messages
+// Module announcement messages - effects announce their own name
 const String MODULE_ANNOUNCEMENTS[] = {
   "Modern Font",      // MODE_ALT_FONT
   "Retro Font",       // MODE_MIN_FONT  
-  "Clock Display",    // MODE_CLOCK
-  "Meteor Animation"  // MODE_ANIMATION
+  "Clock Display"     // MODE_CLOCK
 };
 
+int mode_count() {
+  return MODE_EFFECTS + (effects ? effects->getCount() : 0);
+}
+
+const char* mode_name(int mode) {
+  return mode < MODE_EFFECTS ? mode_names[mode] : effects->get(mode - MODE_EFFECTS)->getName();
+}
+
+String module_announcement(int mode) {
+  return mode < MODE_EFFECTS ? MODULE_ANNOUNCEMENTS[mode] : String(mode_name(mode));
+}
+
 // Module state tracking
 bool current_module_announced = false;
 bool current_module_complete = false;
@@ -204,35 +190,22 @@ bool message_complete = false;
 RetroText::SignTextController* modern_sign = nullptr;
 RetroText::SignTextController* retro_sign = nullptr;
 
-// Callback functions for SignTextController integration
-void render_character_callback(uint8_t character, int pixel_offset, uint8_t brightness, bool use_alt_font) {
-  if (display_manager) {
-    // Get character pattern
-    uint8_t pattern[6];
-    for (int row = 0; row < 6; row++) {
-      pattern[row] = display_manager->getCharacterPattern(character, row, use_alt_font);
-    }
-    // Draw character using DisplayManager
-    display_manager->drawCharacter(pattern, pixel_offset, brightness);
-  }
-}
-
-void clear_display_callback() {
-  if (display_manager) {
-    display_manager->clearBuffer();
-  }
-}
-
-void draw_display_callback() {
-  if (display_manager) {
-    display_manager->updateDisplay();
+// Announcements, status and the modern font story all play through this
+// queue on modern_sign, so nothing blocks the loop and alerts can interrupt
+// the story and let it resume where it was
+RetroText::MessageQueue* message_queue = nullptr;
+bool queue_has_display = false;  // A queued message is on screen - modules hold off
+
+// A story finished scrolling: text modules are done, so demo mode switches
+// on the same loop pass with no idle frames
+void on_story_complete() {
+  if (!current_module_complete) {
+    current_module_complete = true;
+    message_complete = true;
+    Serial.printf("%s complete\n", mode_name(current_mode));
   }
 }
 
-uint8_t brightness_callback(char c, String text, int char_pos, bool is_time_display) {
-  return get_character_brightness(c, text, char_pos, is_time_display);
-}
-
 // Initialize the SignTextController instances
 void init_sign_controllers() {
   if (!display_manager) {
@@ -248,17 +221,17 @@ void init_sign_controllers() {
   modern_sign = new RetroText::SignTextController(max_chars, char_width);
   modern_sign->setFont(RetroText::MODERN_FONT);
   modern_sign->setScrollStyle(RetroText::SMOOTH);  // Use smooth scrolling
-  modern_sign->setScrollSpeed(40);  // Use slower speed like retro
+  modern_sign->setScrollVelocity(25);  // Pixels per second, independent of loop timing
+  modern_sign->setScrollEasing(RetroText::EASE_IN_OUT, 400);
+  modern_sign->setSubpixelScroll(true);  // Blend between pixel steps instead of jumping
   modern_sign->setCharacterSpacing(1);  // Add 1-pixel spacing for better readability
   modern_sign->setBrightness(TEXT_DEFAULT_BRIGHTNESS);
   
-  // Use callbacks instead of DisplayManager directly
-  modern_sign->setRenderCallback(render_character_callback);
-  modern_sign->setClearCallback(clear_display_callback);
-  modern_sign->setDrawCallback(draw_display_callback);
-  modern_sign->setBrightnessCallback(brightness_callback);
+  // Draw straight into the DisplayManager so scrolling uses the message strip
+  modern_sign->setDisplayManager(display_manager);
+  modern_sign->setStyleRule(&headline_style);
   
-  Serial.printf("Modern sign setup complete with callbacks\n");
+  Serial.printf("Modern sign setup complete\n");
   
   // Create retro font controller
   Serial.printf("Creating retro sign: %d chars, %d pixels per char\n", max_chars, char_width);
@@ -268,48 +241,27 @@ void init_sign_controllers() {
   retro_sign->setScrollStyle(RetroText::CHARACTER);
   retro_sign->setScrollSpeed(130);
   retro_sign->setBrightness(TEXT_DEFAULT_BRIGHTNESS);
-  retro_sign->setRenderCallback(render_character_callback);
-  retro_sign->setClearCallback(clear_display_callback);
-  retro_sign->setDrawCallback(draw_display_callback);
-  retro_sign->setBrightnessCallback(brightness_callback);
+  retro_sign->setDisplayManager(display_manager);
+  retro_sign->setStyleRule(&headline_style);
+  retro_sign->setRepeat(true);  // User mode keeps the story going
+  retro_sign->setOnComplete(on_story_complete);
+  
+  message_queue = new RetroText::MessageQueue(modern_sign);
+  modern_sign->setOnComplete([]() {
+    // The queue also plays announcements on this sign - only the story counts
+    if (message_queue->getCurrentPriority() == RetroText::PRIORITY_NORMAL) {
+      on_story_complete();
+    }
+  });
   
   Serial.println("SignTextController instances initialized");
 }
 
-// Helper function to display a static message using SignTextController
-void display_static_message(String message, bool use_modern_font = true, int display_time_ms = 2000) {
-  RetroText::SignTextController* sign = use_modern_font ? modern_sign : retro_sign;
-  
-  // Save the original scroll style
-  RetroText::ScrollStyle original_style = sign->getScrollStyle();
-  
-  // Temporarily set to static for announcement
-  sign->setScrollStyle(RetroText::STATIC);
-  sign->setMessage(message);
-  sign->reset();
-  sign->update();
-  
-  if (display_time_ms > 0) {
-    delay(display_time_ms);
-  }
-  
-  // Restore the original scroll style
-  sign->setScrollStyle(original_style);
-}
-
-// Helper function to display a scrolling message using SignTextController
-void display_scrolling_message(String message, bool use_modern_font = true, bool smooth_scroll = true) {
-  RetroText::SignTextController* sign = use_modern_font ? modern_sign : retro_sign;
-  
-  sign->setScrollStyle(smooth_scroll ? RetroText::SMOOTH : RetroText::CHARACTER);
-  sign->setMessage(message);
-  sign->reset();
-  
-  // Run until complete
-  while (!sign->isComplete()) {
-    sign->update();
-    delay(10);
-  }
+// Queue a static status message ahead of the story; it shows on the next
+// queue update and stays up for display_time_ms without blocking
+void display_static_message(String message, int display_time_ms = 2000) {
+  message_queue->enqueue(message, RetroText::PRIORITY_ALERT, RetroText::STATIC, display_time_ms);
+  message_queue->update();  // Draw now - setup() may block on WiFi next
 }
 
 
@@ -321,13 +273,13 @@ void select_random_message() {
 }
 
 // Show brief module announcement
-void show_module_announcement(DisplayMode mode) {
-  if (mode >= 0 && mode < 4) {
-    String announcement = MODULE_ANNOUNCEMENTS[mode];
+void show_module_announcement(int mode) {
+  if (mode >= 0 && mode < mode_count()) {
+    String announcement = module_announcement(mode);
     Serial.printf("Announcing module: %s\n", announcement.c_str());
     
     // Use modern font for all announcements, brief display
-    display_static_message(announcement, true, 1000);  // 1 second display
+    display_static_message(announcement, 1000);  // 1 second display
   }
 }
 
@@ -338,69 +290,30 @@ void update_current_module() {
   if (!current_module_announced && should_announce) {
     show_module_announcement(current_mode);
     current_module_announced = true;
-    Serial.printf("Announced module: %s\n", MODULE_ANNOUNCEMENTS[current_mode].c_str());
+    Serial.printf("Announced module: %s\n", module_announcement(current_mode).c_str());
   }
   
   // Run the module
   switch (current_mode) {
     case MODE_ALT_FONT:
-      // Modern font - smooth scrolling text
-      smooth_scroll_story();
-      // Check if message scrolling is complete
-      if (!current_module_complete) {
-        static unsigned long modern_start_time = 0;
-        if (modern_start_time == 0) {
-          modern_start_time = millis();
-          Serial.println("Starting Modern Font module timing");
-        }
-        // Consider complete after message has had time to scroll
-        unsigned long elapsed = millis() - modern_start_time;
-        unsigned long required_time = current_message.length() * 200; // Estimate scroll time
-        if (elapsed > required_time) {
-          current_module_complete = true;
-          message_complete = true;
-          modern_start_time = 0;
-          Serial.printf("Modern Font complete after %lu ms\n", elapsed);
-        }
-      }
-      break;
-      
     case MODE_MIN_FONT:
-      // Retro font - character scrolling text using SignTextController
-      // Note: This is handled by the retro_sign controller which is updated in smooth_scroll_story
-      // For now, we'll use the same controller approach but with retro font settings
-      smooth_scroll_story(); // This handles both modern and retro fonts based on controller setup
-      // Check if message scrolling is complete
-      if (!current_module_complete) {
-        static unsigned long retro_start_time = 0;
-        if (retro_start_time == 0) {
-          retro_start_time = millis();
-          Serial.println("Starting Retro Font module timing");
-        }
-        // Consider complete after message has had time to scroll
-        unsigned long elapsed = millis() - retro_start_time;
-        unsigned long required_time = current_message.length() * 180; // Estimate scroll time
-        if (elapsed > required_time) {
-          current_module_complete = true;
-          message_complete = true;
-          retro_start_time = 0;
-          Serial.printf("Retro Font complete after %lu ms\n", elapsed);
-        }
-      }
+      // Text modules - the signs' on-complete hooks mark the module done
+      // the moment the story has scrolled through (see on_story_complete)
+      smooth_scroll_story();
       break;
       
     case MODE_CLOCK:
       // Clock display - continuous updates using ClockDisplay module
-      if (clock_display) {
+      if (clock_display && !queue_has_display) {
         clock_display->update();
       }
       current_module_complete = true;  // Non-text modules are always "complete"
       break;
       
-    case MODE_ANIMATION:
-      // Meteor animation - continuous updates using MeteorAnimation module
-      if (meteor_animation) {
-        meteor_animation->update();
+    default:
+      // Ambient effect - the registry paces it and keeps it within budget
+      if (!queue_has_display) {
+        effects->update();
       }
       current_module_complete = true;  // Non-text modules are always "complete"
       break;
@@ -413,16 +326,17 @@ void update_current_module() {
 
 // Smooth scrolling story text using SignTextController - adapts to current mode
 void smooth_scroll_story() {
-  // Use the appropriate controller based on current mode
-  RetroText::SignTextController* active_sign = nullptr;
-  
   if (current_mode == MODE_ALT_FONT) {
-    active_sign = modern_sign;
-  } else if (current_mode == MODE_MIN_FONT) {
-    active_sign = retro_sign;
+    // The modern sign belongs to the message queue: keep the story queued
+    // behind any announcements, restarting it each time it scrolls through
+    if (message_queue->isIdle()) {
+      message_queue->enqueue(current_message, RetroText::PRIORITY_NORMAL, RetroText::SMOOTH);
+    }
+    return;
   }
   
-  if (!active_sign) return;
+  RetroText::SignTextController* active_sign = current_mode == MODE_MIN_FONT ? retro_sign : nullptr;
+  if (!active_sign || queue_has_display) return;
   
   static String last_message = "";
   
@@ -434,15 +348,12 @@ void smooth_scroll_story() {
     active_sign->setMessage(current_message);
     active_sign->reset();
     last_message = current_message;
+    Serial.printf("Scroll takes %lu ms\n", (unsigned long)active_sign->estimatedDurationMs());
   }
   
-  // Call update every loop - let the controller handle its own timing
+  // Call update every loop - let the controller handle its own timing.
+  // The sign repeats by itself and reports each pass through its hook
   active_sign->update();
-    
-    // Reset when complete for continuous scrolling
-  if (active_sign->isComplete()) {
-    active_sign->reset();
-  }
 }
 
 // font_test_2 removed - functionality replaced by SignTextController
@@ -458,40 +369,50 @@ void configModeCallback(WiFiManager *myWiFiManager) {
   Serial.println("AP SSID: " + myWiFiManager->getConfigPortalSSID());
   Serial.println("AP IP: " + WiFi.softAPIP().toString());
   
-  // Display AP configuration message with smooth scrolling
+  // Display AP configuration message ahead of everything else; it fits the
+  // display, so the first frame stays readable while the portal blocks
   String ap_message = "config wifi via AP";
-  display_scrolling_message(ap_message, true, true); // Use modern font with smooth scrolling
+  message_queue->enqueue(ap_message, RetroText::PRIORITY_URGENT, RetroText::SMOOTH, 2000);
+  message_queue->update();
+}
+
+// Move to the next mode, wrapping after the last effect
+void advance_mode() {
+  current_mode = (current_mode + 1) % mode_count();
+  effects->select(current_mode >= MODE_EFFECTS ? current_mode - MODE_EFFECTS : -1);
 }
 
 // Mode switching functions
 void switch_mode() {
-  current_mode = (DisplayMode)((current_mode + 1) % 4);
+  advance_mode();
   demo_mode_enabled = false;  // Disable demo mode when user manually switches
   user_mode_enabled = true;   // Enable user-controlled mode
   last_mode_change = millis();  // Reset timer
   
-  // Reset module state
+  // Reset module state - the previous story and announcement are stale
   current_module_announced = false;
   current_module_complete = false;
   message_complete = false;
+  message_queue->clear();
   
   // Select random message when switching to text modes
   if (current_mode == MODE_ALT_FONT || current_mode == MODE_MIN_FONT) {
     select_random_message();
   }
   
-  Serial.printf("User switched to %s mode\n", mode_names[current_mode]);
+  Serial.printf("User switched to %s mode\n", mode_name(current_mode));
 }
 
 // Auto-switching function that doesn't disable demo mode
 void auto_switch_mode() {
-  current_mode = (DisplayMode)((current_mode + 1) % 4);
+  advance_mode();
   last_mode_change = millis();  // Reset timer
   
-  // Reset module state
+  // Reset module state - the previous story and announcement are stale
   current_module_announced = false;
   current_module_complete = false;
   message_complete = false;
+  message_queue->clear();
   
   // If we completed a full cycle, increment demo loop count
   if (current_mode == MODE_ALT_FONT) {
@@ -504,7 +425,7 @@ void auto_switch_mode() {
     select_random_message();
   }
   
-  Serial.printf("Auto-switched to %s mode (demo loop %d)\n", mode_names[current_mode], demo_loop_count);
+  Serial.printf("Auto-switched to %s mode (demo loop %d)\n", mode_name(current_mode), demo_loop_count);
 }
 
 // Display font name with button interrupt capability
@@ -569,6 +490,8 @@ bool check_button_press() {
   return false;
 }
 
+// Unit test builds bring their own setup()/loop()
+#ifndef PIO_UNIT_TESTING
 
 void setup() {
   // Initialize serial and I2C.
@@ -583,7 +506,15 @@ void setup() {
   
   // Initialize display manager first
   Serial.println("Initializing DisplayManager...");
-  display_manager = new DisplayManager(NUM_BOARDS, WIDTH, HEIGHT);
+  display_manager = new DisplayManager(NUM_BOARDS, WIDTH, HEIGHT, BOARD_ROWS);
+#if I2C_MUX_ADDRESS
+  display_manager->configureMux(0, I2C_MUX_ADDRESS);
+#endif
+#if I2C_BUS1_SDA >= 0
+  display_manager->configureBus(1, I2C_BUS1_SDA, I2C_BUS1_SCL);
+  display_manager->setBoardConfig(1, 1, ADDR::VCC);
+  display_manager->setBoardConfig(2, 1, ADDR::SDA);
+#endif
   if (!display_manager->initialize()) {
     Serial.println("FATAL: DisplayManager initialization failed!");
     while(1) delay(1000); // Halt
@@ -603,15 +534,29 @@ void setup() {
     delay(3000); // Give user time to read the warning
   }
   
+  // Flush frames from core 0 so rendering on the loop core overlaps I2C transfers
+  display_manager->startAsyncFlush(0);
+  
   // Initialize Clock Display
   Serial.println("Initializing ClockDisplay...");
   clock_display = new ClockDisplay(display_manager, &wifiTimeLib);
   clock_display->initialize();
   
-  // Initialize Meteor Animation
-  Serial.println("Initializing MeteorAnimation...");
+  // Register the ambient effects - each becomes a display mode after Clock
+  Serial.println("Initializing effects...");
+  effects = new EffectRegistry(display_manager);
   meteor_animation = new MeteorAnimation(display_manager);
-  meteor_animation->initialize();
+  effects->add(meteor_animation);
+  effects->add(new LifeEffect());
+  effects->add(new ElementaryEffect(30));
+  effects->add(new ElementaryEffect(110));
+  effects->add(new RainEffect());
+  effects->add(new SparkleEffect());
+  effects->add(new NoiseEffect());
+  effects->add(new ShaderEffect("Plasma", ShaderEffect::plasma));
+  effects->add(new ShaderEffect("Waves", ShaderEffect::waves));
+  effects->add(new ShaderEffect("Gradient", ShaderEffect::gradient));
+  effects->add(new ShaderEffect("Clouds", ShaderEffect::clouds));
   
   // Initialize messages
   initializeMessages();
@@ -624,7 +569,7 @@ void setup() {
   init_sign_controllers();
   
   // Show connecting message on display (static)
-  display_static_message("WiFi connecting...", true, 500);
+  display_static_message("WiFi connecting...", 500);
   
   // Set up WiFiManager with callback for AP mode
   WiFiManager wm;
@@ -635,20 +580,20 @@ void setup() {
     Serial.println("WiFi connected, syncing time...");
     
     // Show connected message (static)
-    display_static_message("OK! Syncing time...", true, 1000);
+    display_static_message("OK! Syncing time...", 1000);
     
     if (wifiTimeLib.getNTPtime(10, nullptr)) {
       Serial.println("Time synchronized successfully");
       
       // Show success message (static)
-      display_static_message("Time synced.", true, 1000);
+      display_static_message("Time synced.", 1000);
     } else {
       Serial.println("Warning: Time sync failed, clock mode may show incorrect time");
     }
   } else {
     Serial.println("Warning: WiFi connection failed, clock mode will not work properly");
     // Show failure message but continue with demo
-    display_static_message("WiFi failed - demo mode", true, 2000);
+    display_static_message("WiFi failed - demo mode", 2000);
   }
   
   // LED initialization moved to DisplayManager
@@ -678,6 +623,25 @@ void loop()
                   current_module_announced ? "true" : "false",
                   current_module_complete ? "true" : "false",
                   digitalRead(USER_BUTTON) ? "HIGH" : "LOW");
+    if (display_manager) {
+      DisplayManager::FlushStats stats = display_manager->getFlushStats();
+      if (stats.frames_total > 0) {
+        Serial.printf("I2C: %lu bytes/frame avg over %lu frames (last frame %lu bytes, %u writes, %u boards, %u mux selects)\n",
+                      (unsigned long)(stats.bytes_total / stats.frames_total),
+                      (unsigned long)stats.frames_total,
+                      (unsigned long)stats.bytes_last_frame,
+                      stats.bursts_last_frame, stats.boards_last_frame,
+                      stats.selects_last_frame);
+      }
+      display_manager->resetFlushStats();
+    }
+    if (effects && effects->getSelected() >= 0) {
+      const EffectRegistry::Stats& fx = effects->getStats();
+      Serial.printf("Effect: %lu us/frame avg (budget %lu us), %lu drawn, %lu skipped, detail %u\n",
+                    (unsigned long)fx.render_us_avg, (unsigned long)fx.budget_us,
+                    (unsigned long)fx.frames_drawn, (unsigned long)fx.frames_skipped,
+                    fx.detail_level);
+    }
     last_debug = millis();
     first_loop = false;
   }
@@ -688,12 +652,26 @@ void loop()
     // Don't return - continue to update the module
   }
   
+  // Queued messages draw over the current module; when they are done the
+  // module's own sign sends its frame again
+  bool queue_had_display = queue_has_display;
+  queue_has_display = message_queue->update();
+  if (queue_had_display && !queue_has_display) {
+    retro_sign->redraw();
+    if (clock_display && current_mode == MODE_CLOCK) {
+      clock_display->forceUpdate();
+    }
+  }
+  
+  // Always update the current module
+  update_current_module();
+  
   // Demo mode auto-switching logic
   if (demo_mode_enabled) {
     bool should_switch = false;
     
     if (current_mode == MODE_ALT_FONT || current_mode == MODE_MIN_FONT) {
-      // Text modules: switch only when message is complete
+      // Text modules: switch as soon as the story's on-complete hook fired
       should_switch = current_module_complete;
     } else {
       // Non-text modules: switch after timer interval
@@ -702,12 +680,17 @@ void loop()
     
     if (should_switch) {
       auto_switch_mode();
-      // Don't return - continue to update the module
+      update_current_module();  // Start the next module this pass - no idle frame
     }
   }
   
-  // Always update the current module
-  update_current_module();
-  
-  delay(25);  // Small delay for system stability
-}
\ No newline at end of file
+  // Pace passes LOOP_FRAME_MS apart, counting this pass's own work, rather
+  // than sleeping a fixed time after it; sleep at least 1 ms so the WiFi
+  // and idle tasks still get the CPU
+  static unsigned long pass_start = 0;
+  unsigned long spent = millis() - pass_start;
+  delay(spent < LOOP_FRAME_MS - 1 ? LOOP_FRAME_MS - spent : 1);
+  pass_start = millis();
+}
+
+#endif // PIO_UNIT_TESTING
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "DisplayManager.h"
+#include "SignTextController.h"
+#include "MessageQueue.h"
+
+// On-device checks of MessageQueue hand-over and hold timing.
+// Run with: pio test -e esp32doit-devkit-v1 -f test_embedded_message_queue
+
+static DisplayManager* display = nullptr;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// setup() queues a status message and then blocks (WiFi, NTP): the
+// message must be on screen before update() returns, even while an older
+// one is still finishing
+void test_finished_message_hands_over_in_same_update(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  sign.setDisplayManager(display);
+  RetroText::MessageQueue queue(&sign);
+
+  queue.enqueue("WiFi connecting...", RetroText::PRIORITY_ALERT, RetroText::STATIC, 50);
+  TEST_ASSERT_TRUE(queue.update());
+  TEST_ASSERT_EQUAL_STRING("WiFi connecting...", sign.getMessage().c_str());
+
+  delay(80);  // Blocking call - the first message has had its time
+  queue.enqueue("OK! Syncing time...", RetroText::PRIORITY_ALERT, RetroText::STATIC, 50);
+  TEST_ASSERT_TRUE(queue.update());
+  TEST_ASSERT_EQUAL_STRING("OK! Syncing time...", sign.getMessage().c_str());
+  TEST_ASSERT_EQUAL_INT(0, queue.getPendingCount());
+}
+
+// For scrolling styles duration_ms is a hold after the scroll completes,
+// not a minimum total time
+void test_scrolling_message_holds_after_scroll_through(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  sign.setDisplayManager(display);
+  sign.setScrollVelocity(400);  // Pixels per second - a short scroll
+  RetroText::MessageQueue queue(&sign);
+
+  const uint32_t hold_ms = 150;
+  queue.enqueue("A message long enough that it has to scroll", RetroText::PRIORITY_NORMAL,
+                RetroText::SMOOTH, hold_ms);
+  unsigned long completed_at = 0;
+  unsigned long deadline = millis() + 5000;
+  while (!queue.isIdle() && millis() < deadline) {
+    queue.update();
+    if (!completed_at && sign.isComplete()) completed_at = millis();
+    delay(1);
+  }
+  TEST_ASSERT_TRUE(queue.isIdle());
+  TEST_ASSERT_NOT_EQUAL(0, completed_at);
+
+  unsigned long held = millis() - completed_at;
+  TEST_ASSERT_UINT32_WITHIN(20, hold_ms, held);
+}
+
+// An interrupted SMOOTH message resumes at the exact sub-pixel position,
+// not snapped back to the whole pixel
+void test_interrupted_message_resumes_at_subpixel_position(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  sign.setDisplayManager(display);
+  sign.setSubpixelScroll(true);
+  sign.setScrollVelocity(37);  // Slow enough that frames land between pixels
+  RetroText::MessageQueue queue(&sign);
+
+  queue.enqueue("A message long enough that it has to scroll", RetroText::PRIORITY_NORMAL,
+                RetroText::SMOOTH);
+  unsigned long deadline = millis() + 2000;
+  do {
+    queue.update();
+    delay(7);
+  } while ((sign.getCurrentPixelOffset() == 0 || sign.getSubpixelOffset() == 0) && millis() < deadline);
+  int pixels = sign.getCurrentPixelOffset();
+  uint8_t fraction = sign.getSubpixelOffset();
+  TEST_ASSERT_NOT_EQUAL(0, fraction);
+
+  queue.enqueue("ALERT", RetroText::PRIORITY_URGENT, RetroText::STATIC, 30);
+  queue.update();
+  TEST_ASSERT_EQUAL_STRING("ALERT", sign.getMessage().c_str());
+
+  delay(40);
+  queue.update();  // The alert is done; the first frame back shows the saved position
+  TEST_ASSERT_EQUAL_STRING("A message long enough that it has to scroll", sign.getMessage().c_str());
+  TEST_ASSERT_EQUAL_INT(pixels, sign.getCurrentPixelOffset());
+  TEST_ASSERT_EQUAL_UINT8(fraction, sign.getSubpixelOffset());
+}
+
+// A message interrupted during its final-frame hold only holds for the
+// rest of duration_ms when it comes back
+void test_interrupted_hold_is_not_repeated(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  sign.setDisplayManager(display);
+  sign.setScrollVelocity(400);
+  RetroText::MessageQueue queue(&sign);
+
+  const uint32_t hold_ms = 200;
+  queue.enqueue("A message long enough that it has to scroll", RetroText::PRIORITY_NORMAL,
+                RetroText::SMOOTH, hold_ms);
+  unsigned long deadline = millis() + 5000;
+  while (!sign.isComplete() && millis() < deadline) {
+    queue.update();
+    delay(1);
+  }
+  TEST_ASSERT_TRUE(sign.isComplete());
+  unsigned long hold_start = millis();
+  while (millis() - hold_start < 120) {
+    queue.update();
+    delay(1);
+  }
+
+  queue.enqueue("ALERT", RetroText::PRIORITY_URGENT, RetroText::STATIC, 30);
+  queue.update();
+  TEST_ASSERT_EQUAL_STRING("ALERT", sign.getMessage().c_str());
+  delay(40);
+
+  queue.update();  // Back to the interrupted message
+  TEST_ASSERT_EQUAL_STRING("A message long enough that it has to scroll", sign.getMessage().c_str());
+  unsigned long resumed_at = millis();
+  while (!queue.isIdle() && millis() < deadline) {
+    queue.update();
+    delay(1);
+  }
+  TEST_ASSERT_TRUE(queue.isIdle());
+  TEST_ASSERT_UINT32_WITHIN(30, hold_ms - 120, millis() - resumed_at);
+}
+
+void setup() {
+  delay(2000);  // Let the serial monitor attach
+  display = new DisplayManager(3, 24, 6);  // Not initialized - frames render without I2C traffic
+
+  UNITY_BEGIN();
+  RUN_TEST(test_finished_message_hands_over_in_same_update);
+  RUN_TEST(test_scrolling_message_holds_after_scroll_through);
+  RUN_TEST(test_interrupted_message_resumes_at_subpixel_position);
+  RUN_TEST(test_interrupted_hold_is_not_repeated);
+  UNITY_END();
+}
+
+void loop() {
+}
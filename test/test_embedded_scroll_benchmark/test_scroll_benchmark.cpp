@@ -0,0 +1,103 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "DisplayManager.h"
+#include "SignTextController.h"
+
+// On-device benchmark: per-frame scroll cost must not depend on text length.
+// Run with: pio test -e esp32doit-devkit-v1 -f test_embedded_scroll_benchmark
+
+// Text of any length in constant memory - a repeating headline-style pattern
+class GeneratedTextSource : public TextSource {
+public:
+  explicit GeneratedTextSource(uint32_t length) : length_(length) {}
+
+  int read(uint32_t position, char* out, int count) override {
+    static const char pattern[] = "The QUICK brown fox 1234 jumps over the LAZY dog. ";
+    static const uint32_t pattern_length = sizeof(pattern) - 1;
+    int copied = 0;
+    while (copied < count && position + copied < length_) {
+      out[copied] = pattern[(position + copied) % pattern_length];
+      copied++;
+    }
+    return copied;
+  }
+  uint32_t length() const override { return length_; }
+
+private:
+  uint32_t length_;
+};
+
+// Frames per measurement: both scroll 40 characters, crossing a window
+// refill, while staying inside a 100-character message
+static const int SMOOTH_FRAMES = 200;
+static const int CHARACTER_FRAMES = 40;
+static DisplayManager* display = nullptr;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// Average microseconds per frame, scrolling from the middle of the text
+static float measureFrameMicros(uint32_t length, RetroText::ScrollStyle style) {
+  GeneratedTextSource source(length);
+  RetroText::CapitalizedWordRule rule(190, 90, 30);
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  sign.setDisplayManager(display);
+  sign.setStyleRule(&rule);
+  sign.setScrollStyle(style);
+  sign.setScrollSpeed(0);  // Every update() renders a frame
+  sign.setSource(&source);
+  if (style == RetroText::CHARACTER) {
+    sign.setScrollChars(length / 2);
+  } else {
+    sign.setScrollPixels(length / 2 * (display->getCharacterWidth() + 1));
+  }
+  sign.update();  // First frame fills the window
+
+  int frames = style == RetroText::CHARACTER ? CHARACTER_FRAMES : SMOOTH_FRAMES;
+  uint32_t start = micros();
+  for (int i = 0; i < frames; i++) {
+    sign.update();
+  }
+  float per_frame = (micros() - start) / (float)frames;
+
+  char line[96];
+  snprintf(line, sizeof(line), "%s %7lu chars: %.1f us/frame",
+           style == RetroText::CHARACTER ? "CHARACTER" : "SMOOTH", (unsigned long)length, per_frame);
+  TEST_MESSAGE(line);
+  return per_frame;
+}
+
+static void checkFlatCost(RetroText::ScrollStyle style) {
+  static const uint32_t LENGTHS[] = {1000, 10000, 100000};
+  float baseline = measureFrameMicros(100, style);
+  for (int i = 0; i < 3; i++) {
+    float cost = measureFrameMicros(LENGTHS[i], style);
+    // Generous margin for cache and interrupt noise; a per-character loop
+    // would be 100x slower at 100k characters
+    TEST_ASSERT_TRUE(cost < baseline * 1.5f + 20.0f);
+  }
+}
+
+void test_smooth_frame_cost_is_flat(void) {
+  checkFlatCost(RetroText::SMOOTH);
+}
+
+void test_character_frame_cost_is_flat(void) {
+  checkFlatCost(RetroText::CHARACTER);
+}
+
+void setup() {
+  delay(2000);  // Let the serial monitor attach
+  display = new DisplayManager(3, 24, 6);  // Not initialized - frames render without I2C traffic
+
+  UNITY_BEGIN();
+  RUN_TEST(test_smooth_frame_cost_is_flat);
+  RUN_TEST(test_character_frame_cost_is_flat);
+  UNITY_END();
+}
+
+void loop() {
+}
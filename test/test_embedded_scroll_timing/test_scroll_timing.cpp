@@ -0,0 +1,92 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "DisplayManager.h"
+#include "SignTextController.h"
+
+// On-device check that estimatedDurationMs() is the time from the first
+// update() to isComplete(), for every scroll mode that completes.
+// Run with: pio test -e esp32doit-devkit-v1 -f test_embedded_scroll_timing
+
+// A loop pass (update() plus delay(1)) is the measurement resolution
+static const uint32_t TOLERANCE_MS = 5;
+static const char* MESSAGE = "Hello WORLD this is a LONG message with 12345 numbers and more TEXT";
+static DisplayManager* display = nullptr;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// Milliseconds from the first update() until the scroll completes
+static uint32_t measureScrollMs(RetroText::SignTextController& sign) {
+  sign.reset();
+  unsigned long start = millis();
+  sign.update();
+  while (!sign.isComplete() && millis() - start < 30000) {
+    delay(1);
+    sign.update();
+  }
+  return millis() - start;
+}
+
+static void checkEstimate(RetroText::SignTextController& sign) {
+  uint32_t estimate = sign.estimatedDurationMs();
+  TEST_ASSERT_TRUE(estimate > 0);
+  TEST_ASSERT_UINT32_WITHIN(TOLERANCE_MS, estimate, measureScrollMs(sign));
+}
+
+static void setUpSign(RetroText::SignTextController& sign, RetroText::ScrollStyle style) {
+  sign.setDisplayManager(display);
+  sign.setScrollStyle(style);
+  sign.setMessage(MESSAGE);
+}
+
+void test_linear_smooth_duration(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  setUpSign(sign, RetroText::SMOOTH);
+  sign.setScrollSpeed(10);
+  checkEstimate(sign);
+  sign.setScrollVelocity(133);  // Pixels per second, not a whole number of ms per pixel
+  checkEstimate(sign);
+}
+
+void test_eased_smooth_duration(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  setUpSign(sign, RetroText::SMOOTH);
+  sign.setScrollVelocity(133);
+  sign.setScrollEasing(RetroText::EASE_IN_OUT, 400);
+  checkEstimate(sign);
+}
+
+void test_subpixel_smooth_duration(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  setUpSign(sign, RetroText::SMOOTH);
+  sign.setScrollVelocity(133);
+  sign.setSubpixelScroll(true);
+  checkEstimate(sign);
+  sign.setScrollEasing(RetroText::EASE_IN_OUT, 400);
+  checkEstimate(sign);
+}
+
+void test_character_duration(void) {
+  RetroText::SignTextController sign(display->getMaxCharacters(), display->getCharacterWidth());
+  setUpSign(sign, RetroText::CHARACTER);
+  sign.setScrollSpeed(30);
+  checkEstimate(sign);
+}
+
+void setup() {
+  delay(2000);  // Let the serial monitor attach
+  display = new DisplayManager(3, 24, 6);  // Not initialized - frames render without I2C traffic
+
+  UNITY_BEGIN();
+  RUN_TEST(test_linear_smooth_duration);
+  RUN_TEST(test_eased_smooth_duration);
+  RUN_TEST(test_subpixel_smooth_duration);
+  RUN_TEST(test_character_duration);
+  UNITY_END();
+}
+
+void loop() {
+}
@@ -0,0 +1,117 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "DisplayManager.h"
+#include "SignTextController.h"
+#include "ZoneCompositor.h"
+
+// On-device checks of ZoneCompositor placement and per-zone redraws.
+// Run with: pio test -e esp32doit-devkit-v1 -f test_embedded_zone_compositor
+
+static DisplayManager* display = nullptr;
+
+void setUp(void) {
+  display->clearBuffer();
+}
+
+void tearDown(void) {
+}
+
+static uint32_t regionChecksum(int x, int width) {
+  uint32_t sum = 0;
+  for (int y = 0; y < display->getHeight(); y++) {
+    for (int i = x; i < x + width; i++) {
+      sum = sum * 31 + display->getPixel(i, y);
+    }
+  }
+  return sum;
+}
+
+void test_add_zone_rejects_overlap_and_off_display(void) {
+  RetroText::SignTextController clock(6, 4), ticker(12, 4), extra(6, 4);
+  RetroText::ZoneCompositor zones(display);
+  TEST_ASSERT_TRUE(zones.addZone(&clock, 0));
+  TEST_ASSERT_FALSE(zones.addZone(&ticker, 20));   // Overlaps the clock
+  TEST_ASSERT_FALSE(zones.addZone(&ticker, 48));   // Hangs off the right edge
+  TEST_ASSERT_FALSE(zones.addZone(&extra, 0, 6));  // Below the only row
+  TEST_ASSERT_TRUE(zones.addZone(&ticker, 24));
+  TEST_ASSERT_EQUAL_INT(2, zones.getZoneCount());
+}
+
+// The scrolling ticker changes the buffer every frame; the static clock
+// next to it must keep its cells instead of drawing them all again
+void test_static_zone_keeps_cells_while_ticker_scrolls(void) {
+  RetroText::SignTextController clock(6, 4), ticker(12, 4);
+  clock.setScrollStyle(RetroText::STATIC);
+  clock.setMessage("12:34");
+  ticker.setScrollVelocity(200);
+  ticker.setMessage("Ticker text long enough to keep scrolling for a while");
+  RetroText::ZoneCompositor zones(display);
+  TEST_ASSERT_TRUE(zones.addZone(&clock, 0));
+  TEST_ASSERT_TRUE(zones.addZone(&ticker, 24));
+
+  zones.update();
+  uint32_t clock_draws = clock.getDrawCount();
+  uint32_t clock_pixels = regionChecksum(0, 24);
+  TEST_ASSERT_TRUE(clock_draws > 0);
+
+  uint32_t ticker_draws = ticker.getDrawCount();
+  for (int frame = 0; frame < 50; frame++) {
+    delay(10);
+    zones.update();
+  }
+  TEST_ASSERT_TRUE(ticker.getDrawCount() > ticker_draws);
+  TEST_ASSERT_EQUAL_UINT32(clock_draws, clock.getDrawCount());
+  TEST_ASSERT_EQUAL_UINT32(clock_pixels, regionChecksum(0, 24));  // Ticker stays in its viewport
+}
+
+// On a shared display other zones move the buffer version every frame; a
+// STATIC controller still draws only the cells whose text changed
+void test_shared_static_controller_draws_only_changed_cells(void) {
+  RetroText::SignTextController clock(6, 4);
+  clock.setScrollStyle(RetroText::STATIC);
+  clock.setDisplayManager(display);
+  clock.setSharedDisplay(true);
+  clock.setMessage("12:34");
+  clock.update();
+
+  display->setPixel(0, 0, 99);  // Marker in the first cell, like another zone's draw
+  clock.setMessage("12:35");
+  clock.update();
+  TEST_ASSERT_EQUAL_UINT8(99, display->getPixel(0, 0));  // Cell 0 not drawn again
+
+  clock.setSharedDisplay(false);  // Alone, any buffer change redraws every cell
+  display->setPixel(0, 0, 98);
+  clock.setMessage("12:36");
+  clock.update();
+  TEST_ASSERT_EQUAL_UINT8(0, display->getPixel(0, 0));
+}
+
+// Something outside the zones drawing over them makes every zone draw again
+void test_outside_draw_redraws_zones(void) {
+  RetroText::SignTextController clock(6, 4);
+  clock.setScrollStyle(RetroText::STATIC);
+  clock.setMessage("12:34");
+  RetroText::ZoneCompositor zones(display);
+  TEST_ASSERT_TRUE(zones.addZone(&clock, 0));
+  zones.update();
+  uint32_t clock_pixels = regionChecksum(0, 24);
+
+  display->fillBuffer(77);
+  zones.update();
+  TEST_ASSERT_EQUAL_UINT32(clock_pixels, regionChecksum(0, 24));
+}
+
+void setup() {
+  delay(2000);  // Let the serial monitor attach
+  display = new DisplayManager(3, 24, 6);  // Not initialized - frames render without I2C traffic
+
+  UNITY_BEGIN();
+  RUN_TEST(test_add_zone_rejects_overlap_and_off_display);
+  RUN_TEST(test_static_zone_keeps_cells_while_ticker_scrolls);
+  RUN_TEST(test_shared_static_controller_draws_only_changed_cells);
+  RUN_TEST(test_outside_draw_redraws_zones);
+  UNITY_END();
+}
+
+void loop() {
+}
@@ -1,4 +1,17 @@
 #include <unity.h>
+#include "PanelLayout.h"
+#include "BurstPlanner.h"
+#include "BoardChain.h"
+#include "Tca9548aMux.h"
+#include "TextSource.h"
+#include "PixelKernels.h"
+#include "ParticleSystem.h"
+#include "Bitboard.h"
+#include "CellularEffects.h"
+#include "FixedMath.h"
+#include "ShaderEffect.h"
+#include "ZoneGeometry.h"
+#include <string.h>
 
 
 void setUp(void) {
@@ -9,10 +22,686 @@ void tearDown(void) {
     // Clean up code here, to run after each test
 }
 
+// Default 3-board chain must match the original hand-written setPixel transform
+void test_retrotext_pcb_coordinate_conversion(void) {
+    const int num_boards = 3, board_width = 24, board_height = 6;
+    const int width = num_boards * board_width;
+    BoardPlacement placements[num_boards];
+    int count = PanelLayout::defaultChain(num_boards, board_width, board_height, placements);
+
+    PanelLayout layout;
+    TEST_ASSERT_TRUE(layout.build(placements, count, num_boards, width, board_height));
+
+    for (int y = 0; y < board_height; y++) {
+        for (int x = 0; x < width; x++) {
+            int screen_x = width - x - 1;
+            int screen_y = board_height - y - 1;
+            int local_x = screen_x % board_width;
+            int char_index = local_x / 4;
+            int expected_x = (char_index % 3) * 4 + local_x % 4;
+            int expected_y = screen_y + (char_index < 3 ? 0 : 6);
+
+            const PhysicalPixel& p = layout.lookup(x, y);
+            TEST_ASSERT_EQUAL_INT(screen_x / board_width, p.board);
+            TEST_ASSERT_EQUAL_INT(expected_x, p.x);
+            TEST_ASSERT_EQUAL_INT(expected_y, p.y);
+            TEST_ASSERT_EQUAL_INT(expected_y * 16 + (expected_x < 6 ? expected_x : expected_x + 2),
+                                  p.pwm_register);
+        }
+    }
+}
+
+void test_layout_reordered_and_mirrored_boards(void) {
+    // Two upright boards wired left-to-right in reverse order, second one mirrored
+    BoardPlacement placements[] = {
+        {1, 0, 0, BoardRotation::ROTATE_0, false},
+        {0, 24, 0, BoardRotation::ROTATE_0, true},
+    };
+    PanelLayout layout;
+    TEST_ASSERT_TRUE(layout.build(placements, 2, 2, 48, 6));
+
+    TEST_ASSERT_EQUAL_INT(1, layout.lookup(0, 0).board);
+    TEST_ASSERT_EQUAL_INT(0, layout.lookup(0, 0).x);
+    TEST_ASSERT_EQUAL_INT(0, layout.lookup(0, 0).y);
+
+    // Leftmost column of the mirrored board is its native column 23 (char 5)
+    TEST_ASSERT_EQUAL_INT(0, layout.lookup(24, 2).board);
+    TEST_ASSERT_EQUAL_INT(11, layout.lookup(24, 2).x);
+    TEST_ASSERT_EQUAL_INT(8, layout.lookup(24, 2).y);
+}
+
+// A board index past the chain would index per-board arrays out of range
+void test_layout_rejects_board_past_chain(void) {
+    BoardPlacement good[] = {{0, 0, 0, BoardRotation::ROTATE_0, false}};
+    PanelLayout layout;
+    TEST_ASSERT_TRUE(layout.build(good, 1, 1, 24, 6));
+
+    BoardPlacement bad[] = {{1, 0, 0, BoardRotation::ROTATE_180, false}};
+    TEST_ASSERT_FALSE(layout.build(bad, 1, 1, 24, 6));
+
+    // The previous table is untouched
+    TEST_ASSERT_EQUAL_INT(0, layout.lookup(0, 0).board);
+    TEST_ASSERT_EQUAL_INT(0, layout.lookup(0, 0).x);
+    TEST_ASSERT_EQUAL_INT(0, layout.lookup(0, 0).y);
+}
+
+void test_layout_rotated_board_and_gaps(void) {
+    // A single board stood on end in a 6x24 display
+    BoardPlacement vertical[] = {{0, 0, 0, BoardRotation::ROTATE_90, false}};
+    PanelLayout layout;
+    TEST_ASSERT_TRUE(layout.build(vertical, 1, 1, 6, 24));
+    // Native (0,5) is the top-left footprint pixel after a clockwise quarter turn
+    TEST_ASSERT_EQUAL_INT(0, layout.lookup(0, 0).x);
+    TEST_ASSERT_EQUAL_INT(5, layout.lookup(0, 0).y);
+
+    // Uncovered pixels report NO_BOARD, out-of-range placements are rejected
+    BoardPlacement partial[] = {{0, 0, 0, BoardRotation::ROTATE_0, false}};
+    TEST_ASSERT_TRUE(layout.build(partial, 1, 1, 48, 6));
+    TEST_ASSERT_EQUAL_INT(PanelLayout::NO_BOARD, layout.lookup(30, 0).board);
+    BoardPlacement outside[] = {{0, 30, 0, BoardRotation::ROTATE_0, false}};
+    TEST_ASSERT_FALSE(layout.build(outside, 1, 1, 48, 6));
+}
+
+void test_burst_planner_unknown_state_sends_everything(void) {
+    uint8_t next[192] = {0};
+    RegisterBurst bursts[192 / 2 + 1];
+    int count = BurstPlanner::plan(nullptr, next, 192, 4, 64, bursts);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    TEST_ASSERT_EQUAL_INT(0, bursts[0].start);
+    TEST_ASSERT_EQUAL_INT(64, bursts[0].length);
+    TEST_ASSERT_EQUAL_INT(128, bursts[2].start);
+    TEST_ASSERT_EQUAL_INT(64, bursts[2].length);
+    TEST_ASSERT_EQUAL_INT(192 + 3 * BurstPlanner::TRANSACTION_OVERHEAD,
+                          BurstPlanner::wireBytes(bursts, count));
+}
+
+void test_burst_planner_coalesces_short_gaps(void) {
+    uint8_t sent[192], next[192];
+    memset(sent, 0, sizeof(sent));
+    memcpy(next, sent, sizeof(next));
+    RegisterBurst bursts[192 / 2 + 1];
+
+    TEST_ASSERT_EQUAL_INT(0, BurstPlanner::plan(sent, next, 192, 4, 64, bursts));
+
+    // Changes at 10, 13 (gap of 2 -> merged) and 40 (gap too long -> new burst)
+    next[10] = 1;
+    next[13] = 2;
+    next[40] = 3;
+    int count = BurstPlanner::plan(sent, next, 192, 4, 64, bursts);
+    TEST_ASSERT_EQUAL_INT(2, count);
+    TEST_ASSERT_EQUAL_INT(10, bursts[0].start);
+    TEST_ASSERT_EQUAL_INT(4, bursts[0].length);
+    TEST_ASSERT_EQUAL_INT(40, bursts[1].start);
+    TEST_ASSERT_EQUAL_INT(1, bursts[1].length);
+
+    // Trailing unchanged registers are never sent
+    next[191] = 9;
+    count = BurstPlanner::plan(sent, next, 192, 4, 64, bursts);
+    TEST_ASSERT_EQUAL_INT(191, bursts[count - 1].start);
+    TEST_ASSERT_EQUAL_INT(1, bursts[count - 1].length);
+}
+
+void test_burst_planner_respects_max_length(void) {
+    uint8_t sent[192], next[192];
+    memset(sent, 0, sizeof(sent));
+    memset(next, 7, sizeof(next));
+    RegisterBurst bursts[192 / 2 + 1];
+    int count = BurstPlanner::plan(sent, next, 192, 4, 50, bursts);
+    int covered = 0;
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_LESS_OR_EQUAL(50, bursts[i].length);
+        TEST_ASSERT_EQUAL_INT(covered, bursts[i].start);
+        covered += bursts[i].length;
+    }
+    TEST_ASSERT_EQUAL_INT(192, covered);
+}
+
+// I2C bus with a TCA9548A at 0x70 and IS31FL3737 register files behind it.
+// Slot 0 is the trunk, slots 1-8 are mux channels 0-7; 4 ADDR options each.
+class MockMuxBus : public I2CBus {
+public:
+    static const uint8_t MUX_ADDRESS = 0x70;
+
+    struct Device {
+        bool present;
+        bool unlocked;
+        uint8_t page;
+        uint8_t pages[4][256];
+    };
+
+    Device devices[1 + Tca9548aMux::CHANNEL_COUNT][4];
+    uint8_t mux_mask;
+    int mux_writes;
+    int transactions;
+
+    MockMuxBus() : mux_mask(0), mux_writes(0), transactions(0) {
+        memset(devices, 0, sizeof(devices));
+    }
+
+    static int slotOf(uint8_t mux_channel) {
+        return mux_channel == BoardChain::NO_MUX_CHANNEL ? 0 : mux_channel + 1;
+    }
+
+    static int addressIndex(uint8_t address) {
+        switch (address) {
+            case 0x50: return 0;
+            case 0x5A: return 1;
+            case 0x5F: return 2;
+            case 0x54: return 3;
+            default: return -1;
+        }
+    }
+
+    Device& device(uint8_t mux_channel, uint8_t address) {
+        return devices[slotOf(mux_channel)][addressIndex(address)];
+    }
+
+    // The one device answering at `address` with the current mux setting;
+    // nullptr if none does or two would collide on the bus
+    Device* reachable(uint8_t address) {
+        int index = addressIndex(address);
+        if (index < 0) return nullptr;
+        Device* found = nullptr;
+        for (int slot = 0; slot <= Tca9548aMux::CHANNEL_COUNT; slot++) {
+            bool connected = slot == 0 || (mux_mask & (1 << (slot - 1)));
+            if (connected && devices[slot][index].present) {
+                if (found) return nullptr;
+                found = &devices[slot][index];
+            }
+        }
+        return found;
+    }
+
+    bool writeRegisters(uint8_t address, uint8_t start_register, const uint8_t* data, int length) override {
+        transactions++;
+        Device* d = reachable(address);
+        if (!d || length > maxWriteLength()) return false;
+        if (start_register == 0xFE) {
+            d->unlocked = data[0] == 0xC5;
+        } else if (start_register == 0xFD) {
+            if (!d->unlocked) return false;
+            d->page = data[0];
+            d->unlocked = false;
+        } else {
+            for (int i = 0; i < length; i++) {
+                d->pages[d->page & 3][(start_register + i) & 0xFF] = data[i];
+            }
+        }
+        return true;
+    }
+
+    bool writeByte(uint8_t address, uint8_t value) override {
+        transactions++;
+        if (address != MUX_ADDRESS) return false;
+        mux_mask = value;
+        mux_writes++;
+        return true;
+    }
+
+    bool probe(uint8_t address) override {
+        transactions++;
+        return address == MUX_ADDRESS || reachable(address) != nullptr;
+    }
+
+    int maxWriteLength() const override { return 127; }
+};
+
+static const uint8_t MOCK_ADDRESSES[4] = {0x50, 0x5A, 0x5F, 0x54};
+
+// 8 boards in two rows of four behind a mux: row 0 on channel 0, row 1 on channel 1
+static void setupMuxGrid(MockMuxBus& bus, Tca9548aMux& mux, BoardChain& chain, PanelLayout& layout) {
+    BoardPlacement placements[8];
+    int count = PanelLayout::defaultGrid(4, 2, 24, 6, placements);
+    TEST_ASSERT_TRUE(layout.build(placements, count, count, 96, 12));
+
+    chain.attachBus(0, &bus, &mux);
+    chain.resize(8);
+    for (int i = 0; i < 8; i++) {
+        bus.device(i / 4, MOCK_ADDRESSES[i % 4]).present = true;
+        chain.setBoard(i, 0, i / 4, MOCK_ADDRESSES[i % 4]);
+        TEST_ASSERT_TRUE(chain.probe(i));
+        TEST_ASSERT_TRUE(chain.initializeBoard(i, 50));
+    }
+}
+
+void test_layout_default_grid_rows(void) {
+    BoardPlacement placements[6];
+    int count = PanelLayout::defaultGrid(3, 2, 24, 6, placements);
+    TEST_ASSERT_EQUAL_INT(6, count);
+    // Each row is a stock chain with its first board on the right
+    TEST_ASSERT_EQUAL_INT(48, placements[0].x);
+    TEST_ASSERT_EQUAL_INT(0, placements[0].y);
+    TEST_ASSERT_EQUAL_INT(0, placements[2].x);
+    TEST_ASSERT_EQUAL_INT(48, placements[3].x);
+    TEST_ASSERT_EQUAL_INT(6, placements[3].y);
+    TEST_ASSERT_EQUAL_INT(5, placements[5].board);
+
+    PanelLayout layout;
+    TEST_ASSERT_TRUE(layout.build(placements, count, count, 72, 12));
+    TEST_ASSERT_EQUAL_INT(2, layout.lookup(0, 0).board);
+    TEST_ASSERT_EQUAL_INT(3, layout.lookup(71, 11).board);
+}
+
+void test_board_chain_full_frame_behind_mux(void) {
+    MockMuxBus bus;
+    Tca9548aMux mux(&bus);
+    BoardChain chain;
+    PanelLayout layout;
+    setupMuxGrid(bus, mux, chain, layout);
+
+    // Every driver came out of init with its LEDs on and normal operation set
+    for (int i = 0; i < 8; i++) {
+        MockMuxBus::Device& d = bus.device(i / 4, MOCK_ADDRESSES[i % 4]);
+        TEST_ASSERT_EQUAL_HEX8(0xFF, d.pages[0][0x17]);
+        TEST_ASSERT_EQUAL_HEX8(0x01, d.pages[3][0x00]);
+        TEST_ASSERT_EQUAL_INT(50, d.pages[3][0x01]);
+    }
+
+    uint8_t frame[96 * 12];
+    for (int i = 0; i < 96 * 12; i++) frame[i] = (uint8_t)(i * 7 + 1);
+    bool dirty[8];
+    memset(dirty, 1, sizeof(dirty));
+    chain.flushBus(0, frame, layout.table(), 96 * 12, dirty, 255);
+
+    for (int i = 0; i < 96 * 12; i++) {
+        const PhysicalPixel& p = layout.table()[i];
+        MockMuxBus::Device& d = bus.device(p.board / 4, MOCK_ADDRESSES[p.board % 4]);
+        TEST_ASSERT_EQUAL_HEX8(frame[i], d.pages[1][p.pwm_register]);
+        TEST_ASSERT_FALSE(dirty[p.board]);
+    }
+    TEST_ASSERT_EQUAL_INT(8, chain.getStats(0).boards_last_frame);
+
+    // Master brightness scales what reaches the chips
+    memset(dirty, 1, sizeof(dirty));
+    chain.flushBus(0, frame, layout.table(), 96 * 12, dirty, 127);
+    const PhysicalPixel& p = layout.table()[5];
+    TEST_ASSERT_EQUAL_HEX8((frame[5] * 128) >> 8,
+                           bus.device(p.board / 4, MOCK_ADDRESSES[p.board % 4]).pages[1][p.pwm_register]);
+}
+
+void test_board_chain_minimizes_mux_selects(void) {
+    MockMuxBus bus;
+    Tca9548aMux mux(&bus);
+    BoardChain chain;
+    PanelLayout layout;
+    setupMuxGrid(bus, mux, chain, layout);
+    TEST_ASSERT_EQUAL_INT(1, mux.getChannel());  // Left on the last board initialized
+
+    uint8_t frame[96 * 12];
+    memset(frame, 20, sizeof(frame));
+    bool dirty[8];
+
+    // First frame: the channel already selected goes first, so one switch
+    memset(dirty, 1, sizeof(dirty));
+    int writes_before = bus.mux_writes;
+    chain.flushBus(0, frame, layout.table(), 96 * 12, dirty, 255);
+    TEST_ASSERT_EQUAL_INT(1, bus.mux_writes - writes_before);
+    TEST_ASSERT_EQUAL_INT(1, chain.getStats(0).selects_last_frame);
+    TEST_ASSERT_EQUAL_INT(0, mux.getChannel());
+
+    // Nothing changed: no selects and no traffic even with every board dirty
+    memset(dirty, 1, sizeof(dirty));
+    int transactions_before = bus.transactions;
+    chain.flushBus(0, frame, layout.table(), 96 * 12, dirty, 255);
+    TEST_ASSERT_EQUAL_INT(0, chain.getStats(0).selects_last_frame);
+    TEST_ASSERT_EQUAL_INT(0, chain.getStats(0).bytes_last_frame);
+    TEST_ASSERT_EQUAL_INT(transactions_before, bus.transactions);
+
+    // A change on the current channel only needs no select
+    frame[0] = 99;  // Top row -> channel 0
+    memset(dirty, 1, sizeof(dirty));
+    chain.flushBus(0, frame, layout.table(), 96 * 12, dirty, 255);
+    TEST_ASSERT_EQUAL_INT(0, chain.getStats(0).selects_last_frame);
+    TEST_ASSERT_EQUAL_INT(1, chain.getStats(0).boards_last_frame);
+
+    // Changes on both channels cost exactly one switch
+    frame[1] = 98;
+    frame[96 * 11] = 97;  // Bottom row -> channel 1
+    memset(dirty, 1, sizeof(dirty));
+    chain.flushBus(0, frame, layout.table(), 96 * 12, dirty, 255);
+    TEST_ASSERT_EQUAL_INT(1, chain.getStats(0).selects_last_frame);
+    TEST_ASSERT_EQUAL_INT(2, chain.getStats(0).boards_last_frame);
+    const PhysicalPixel& p = layout.table()[96 * 11];
+    TEST_ASSERT_EQUAL_INT(97, bus.device(1, MOCK_ADDRESSES[p.board % 4]).pages[1][p.pwm_register]);
+}
+
+void test_memory_text_source_reads_windows(void) {
+    MemoryTextSource source("Hello, world");
+    char out[8];
+    TEST_ASSERT_EQUAL_INT(12, source.length());
+    TEST_ASSERT_EQUAL_INT(5, source.read(0, out, 5));
+    TEST_ASSERT_EQUAL_MEMORY("Hello", out, 5);
+    // Short read at the end, nothing past it
+    TEST_ASSERT_EQUAL_INT(3, source.read(9, out, 8));
+    TEST_ASSERT_EQUAL_MEMORY("rld", out, 3);
+    TEST_ASSERT_EQUAL_INT(0, source.read(12, out, 8));
+    TEST_ASSERT_TRUE(source.isFinished());
+}
+
+void test_ring_text_source_wraps_and_drops_oldest(void) {
+    RingTextSource ring(8);
+    char out[8];
+    TEST_ASSERT_FALSE(ring.isFinished());
+    TEST_ASSERT_EQUAL_INT(0, ring.append("abcdef"));
+    TEST_ASSERT_EQUAL_INT(0, ring.firstAvailable());
+
+    // 4 more characters overflow the 8-character buffer by 2
+    TEST_ASSERT_EQUAL_INT(2, ring.append("ghij"));
+    TEST_ASSERT_EQUAL_INT(10, ring.length());
+    TEST_ASSERT_EQUAL_INT(2, ring.firstAvailable());
+    TEST_ASSERT_EQUAL_INT(0, ring.read(1, out, 4));       // Dropped
+    TEST_ASSERT_EQUAL_INT(8, ring.read(2, out, 8));       // Read spans the wrap
+    TEST_ASSERT_EQUAL_MEMORY("cdefghij", out, 8);
+
+    // An append larger than the buffer keeps only its tail
+    ring.append("0123456789AB");
+    TEST_ASSERT_EQUAL_INT(22, ring.length());
+    TEST_ASSERT_EQUAL_INT(4, ring.read(18, out, 8));
+    TEST_ASSERT_EQUAL_MEMORY("89AB", out, 4);
+
+    ring.finish();
+    TEST_ASSERT_TRUE(ring.isFinished());
+}
+
+void test_ring_text_source_replaces_in_place(void) {
+    RingTextSource ring(8);
+    char out[8];
+    ring.append("abcdefghij");    // Holds "cdefghij" from position 2
+
+    // A replacement spanning the wrap keeps positions and length
+    TEST_ASSERT_EQUAL_INT(3, ring.replace(6, "XYZ", 3));
+    TEST_ASSERT_EQUAL_INT(10, ring.length());
+    TEST_ASSERT_EQUAL_INT(8, ring.read(2, out, 8));
+    TEST_ASSERT_EQUAL_MEMORY("cdefXYZj", out, 8);
+
+    // Dropped text and text past the end are clipped off
+    TEST_ASSERT_EQUAL_INT(2, ring.replace(0, "0123", 4));
+    TEST_ASSERT_EQUAL_INT(1, ring.replace(9, "!?", 2));
+    TEST_ASSERT_EQUAL_INT(0, ring.replace(10, "?", 1));
+    TEST_ASSERT_EQUAL_INT(8, ring.read(2, out, 8));
+    TEST_ASSERT_EQUAL_MEMORY("23efXYZ!", out, 8);
+}
+
+void test_pixel_kernels_subpixel_blend(void) {
+    // Rows: column 0 lights row 0, column 1 rows 0 and 1, column 2 nothing
+    const uint8_t masks[3] = {0x01, 0x03, 0x00};
+    const uint8_t levels[3] = {200, 100, 50};
+    uint8_t left[4], right[4], out[4];
+
+    // No fraction is a straight copy, past the strip is black
+    PixelKernels::blendWeights(levels, 3, 4, 0, left, right);
+    PixelKernels::blendRow(masks, 3, 4, 0, left, right, out);
+    TEST_ASSERT_EQUAL_UINT8(200, out[0]);
+    TEST_ASSERT_EQUAL_UINT8(100, out[1]);
+    TEST_ASSERT_EQUAL_UINT8(0, out[2]);
+    TEST_ASSERT_EQUAL_UINT8(0, out[3]);
+
+    // Half way: each column is half of itself plus half of its right neighbour
+    PixelKernels::blendWeights(levels, 3, 4, 128, left, right);
+    PixelKernels::blendRow(masks, 3, 4, 0, left, right, out);
+    TEST_ASSERT_EQUAL_UINT8(150, out[0]);
+    TEST_ASSERT_EQUAL_UINT8(50, out[1]);
+    TEST_ASSERT_EQUAL_UINT8(0, out[2]);
+    PixelKernels::blendRow(masks, 3, 4, 1, left, right, out);
+    TEST_ASSERT_EQUAL_UINT8(50, out[0]);
+    TEST_ASSERT_EQUAL_UINT8(50, out[1]);
+
+    // Full-brightness neighbours never overflow
+    const uint8_t full[2] = {255, 255};
+    PixelKernels::blendWeights(full, 2, 2, 255, left, right);
+    PixelKernels::blendRow(masks, 2, 2, 0, left, right, out);
+    TEST_ASSERT_EQUAL_UINT8(254, out[0]);
+}
+
+void test_pixel_kernels_layer_blend_modes(void) {
+    // Source pixel 0 is transparent in every mode
+    const uint8_t below[4] = {0, 100, 200, 50};
+    const uint8_t src[4] = {80, 0, 100, 250};
+    const uint8_t replaced[4] = {80, 100, 100, 250};
+    const uint8_t added[4] = {80, 100, 255, 255};     // Saturates
+    const uint8_t maxed[4] = {80, 100, 200, 250};
+    const uint8_t mixed[4] = {40, 100, 150, 150};     // Half alpha: half way between
+    uint8_t out[4];
+
+    memcpy(out, below, 4);
+    PixelKernels::composeReplace(out, src, 4);
+    TEST_ASSERT_EQUAL_MEMORY(replaced, out, 4);
+
+    memcpy(out, below, 4);
+    PixelKernels::composeAdd(out, src, 4);
+    TEST_ASSERT_EQUAL_MEMORY(added, out, 4);
+
+    memcpy(out, below, 4);
+    PixelKernels::composeMax(out, src, 4);
+    TEST_ASSERT_EQUAL_MEMORY(maxed, out, 4);
+
+    memcpy(out, below, 4);
+    PixelKernels::composeAlpha(out, src, 4, 128);
+    TEST_ASSERT_EQUAL_MEMORY(mixed, out, 4);
+}
+
+// Sub-pixel motion, wrap with overshoot kept, and removal at the edge
+void test_particle_system_steps_and_wraps(void) {
+    const int32_t one = ParticleSystem::ONE;
+    ParticleSystem wrap(4);
+    wrap.setBounds(0, 0, 10, 2, ParticleSystem::EDGE_WRAP);
+    TEST_ASSERT_EQUAL_INT(0, wrap.spawn(8 * one, 1 * one, one + one / 2, 0, 200));
+    wrap.step();
+    TEST_ASSERT_EQUAL_INT32(9 * one + one / 2, wrap.getX(0));
+    wrap.step();
+    TEST_ASSERT_EQUAL_INT32(1 * one, wrap.getX(0));   // 11.0 wraps to 1.0
+    TEST_ASSERT_EQUAL_INT32(1 * one, wrap.getY(0));
+
+    ParticleSystem kill(2);
+    kill.setBounds(0, 0, 10, 2, ParticleSystem::EDGE_KILL);
+    kill.spawn(9 * one, 0, one, 0, 200);
+    kill.spawn(1 * one, 0, 0, 0, 100);
+    TEST_ASSERT_EQUAL_INT(-1, kill.spawn(0, 0, 0, 0, 50));   // Full
+    kill.step();
+    TEST_ASSERT_EQUAL_INT(1, kill.getCount());
+    TEST_ASSERT_EQUAL_INT32(1 * one, kill.getX(0));   // Survivor moved into the gap
+}
+
+void test_particle_system_lifetime_and_trail(void) {
+    const int32_t one = ParticleSystem::ONE;
+    ParticleSystem particles(2);
+    particles.setBounds(0, 0, 8, 1, ParticleSystem::EDGE_WRAP);
+    particles.spawn(4 * one, 0, one, 0, 200, 3, 50, 2);
+    particles.step();
+    TEST_ASSERT_EQUAL_INT(1, particles.getCount());
+
+    // Head at x=5, trail fading back against the direction of travel
+    const uint8_t expected[8] = {0, 0, 0, 100, 150, 200, 0, 0};
+    uint8_t frame[8];
+    memset(frame, 0, sizeof(frame));
+    frame[3] = 120;   // Brighter existing pixel is kept
+    particles.render(frame, 8, 1);
+    const uint8_t kept[8] = {0, 0, 0, 120, 150, 200, 0, 0};
+    TEST_ASSERT_EQUAL_MEMORY(kept, frame, 8);
+    memset(frame, 0, sizeof(frame));
+    particles.render(frame, 8, 1);
+    TEST_ASSERT_EQUAL_MEMORY(expected, frame, 8);
+
+    particles.step();
+    TEST_ASSERT_EQUAL_INT(0, particles.getCount());   // Lifetime expired
+}
+
+void test_particle_system_random_is_seeded(void) {
+    ParticleSystem a(1, 42), b(1, 42), c(1, 7);
+    bool differs = false;
+    for (int i = 0; i < 16; i++) {
+        uint32_t value = a.random();
+        TEST_ASSERT_EQUAL_UINT32(value, b.random());
+        differs |= value != c.random();
+        int n = a.random(-3, 5);
+        b.random(-3, 5);
+        TEST_ASSERT_TRUE(n >= -3 && n < 5);
+    }
+    TEST_ASSERT_TRUE(differs);
+}
+
+// Row shifts carry across 32-bit words and wrap around the width
+void test_bitboard_shifts_wrap_across_words(void) {
+    Bitboard board;
+    TEST_ASSERT_TRUE(board.allocate(40, 1));
+    TEST_ASSERT_EQUAL_INT(2, board.getWordsPerRow());
+    board.set(0, 0, true);
+    board.set(31, 0, true);
+    board.set(39, 0, true);
+
+    uint32_t west[2], east[2];
+    board.shiftFromWest(board.row(0), west);
+    board.shiftFromEast(board.row(0), east);
+
+    // shiftFromWest: each cell gets its left neighbour, cell 0 gets cell 39
+    const uint32_t expected_west[2] = {0x00000003u, 0x00000001u};
+    // shiftFromEast: each cell gets its right neighbour, cell 39 gets cell 0
+    const uint32_t expected_east[2] = {0x40000000u, 0x000000C0u};
+    TEST_ASSERT_EQUAL_UINT32(expected_west[0], west[0]);
+    TEST_ASSERT_EQUAL_UINT32(expected_west[1], west[1]);
+    TEST_ASSERT_EQUAL_UINT32(expected_east[0], east[0]);
+    TEST_ASSERT_EQUAL_UINT32(expected_east[1], east[1]);
+    TEST_ASSERT_EQUAL_INT(3, board.count());
+}
+
+// Exposes the cells so a known pattern can be placed
+class TestLifeEffect : public LifeEffect {
+public:
+    Bitboard& cells() { return plane(0); }
+};
+
+void test_life_effect_blinker(void) {
+    const int width = 40, height = 6;
+    TestLifeEffect life;
+    TEST_ASSERT_TRUE(life.init(width, height));
+    life.reset();
+    life.cells().clear();
+    life.cells().set(33, 2, true);   // Horizontal blinker across a word edge
+    life.cells().set(34, 2, true);
+    life.cells().set(35, 2, true);
+
+    life.update(1000 / life.getTargetFps());   // One generation
+    TEST_ASSERT_EQUAL_INT(3, life.cells().count());
+    TEST_ASSERT_TRUE(life.cells().get(34, 1));
+    TEST_ASSERT_TRUE(life.cells().get(34, 2));
+    TEST_ASSERT_TRUE(life.cells().get(34, 3));
+
+    // Newborn cells flash, the survivor is steady, the dead ends fade
+    static uint8_t frame[width * height];
+    life.render(frame);
+    TEST_ASSERT_EQUAL_UINT8(110, frame[1 * width + 34]);
+    TEST_ASSERT_EQUAL_UINT8(70, frame[2 * width + 34]);
+    TEST_ASSERT_EQUAL_UINT8(15, frame[2 * width + 33]);
+    TEST_ASSERT_EQUAL_UINT8(0, frame[0 * width + 34]);
+}
+
+void test_fixed_math_tables_and_blends(void) {
+    TEST_ASSERT_EQUAL_UINT8(128, FixedMath::sin8(0));
+    TEST_ASSERT_EQUAL_UINT8(255, FixedMath::sin8(64));
+    TEST_ASSERT_EQUAL_UINT8(1, FixedMath::sin8(192));
+    TEST_ASSERT_EQUAL_UINT8(FixedMath::sin8(64), FixedMath::cos8(0));
+    TEST_ASSERT_EQUAL_UINT8(0, FixedMath::gamma8(0));
+    TEST_ASSERT_EQUAL_UINT8(255, FixedMath::gamma8(255));
+    TEST_ASSERT_TRUE(FixedMath::gamma8(128) < 64);   // Mid grey is dark in LED levels
+
+    TEST_ASSERT_EQUAL_UINT8(255, FixedMath::scale8(255, 255));
+    TEST_ASSERT_EQUAL_UINT8(100, FixedMath::scale8(200, 127));
+    TEST_ASSERT_EQUAL_UINT8(0, FixedMath::scale8(200, 0));
+    TEST_ASSERT_EQUAL_UINT8(130, FixedMath::lerp8(10, 250, 128));
+    TEST_ASSERT_EQUAL_UINT8(130, FixedMath::lerp8(250, 10, 128));
+    TEST_ASSERT_EQUAL_UINT8(10, FixedMath::lerp8(10, 250, 0));
+    TEST_ASSERT_EQUAL_UINT8(255, FixedMath::qadd8(200, 100));
+    TEST_ASSERT_EQUAL_UINT8(0, FixedMath::qsub8(100, 200));
+
+    // Noise passes through the lattice values and changes smoothly between them
+    TEST_ASSERT_EQUAL_UINT8(FixedMath::hash8(3, 5), FixedMath::noise8(3 << 8, 5 << 8));
+    for (uint16_t x = 3 << 8; x < (4 << 8); x += 8) {
+        int step = FixedMath::noise8(x + 8, 5 << 8) - FixedMath::noise8(x, 5 << 8);
+        TEST_ASSERT_TRUE(step >= -24 && step <= 24);
+    }
+
+    // The lattice wraps: no jump where a coordinate overflows 16 bits
+    TEST_ASSERT_EQUAL_UINT8(FixedMath::hash8(0, 5), FixedMath::noise8(0, 5 << 8));
+    int wrap_x = FixedMath::noise8(0, 5 << 8) - FixedMath::noise8(0xFFF8, 5 << 8);
+    int wrap_y = FixedMath::noise8(3 << 8, 0) - FixedMath::noise8(3 << 8, 0xFFF8);
+    TEST_ASSERT_TRUE(wrap_x >= -24 && wrap_x <= 24);
+    TEST_ASSERT_TRUE(wrap_y >= -24 && wrap_y <= 24);
+}
+
+static uint8_t test_shader(int x, int y, uint32_t t) {
+    return (uint8_t)(x + 10 * y + t);
+}
+
+// Every pixel evaluated, or every n-th column repeated at lower detail
+void test_shader_effect_evaluates_frame(void) {
+    const int width = 5, height = 2;
+    uint8_t frame[width * height];
+    ShaderEffect::evaluate(test_shader, frame, width, height, 100);
+    const uint8_t full[width * height] = {100, 101, 102, 103, 104, 110, 111, 112, 113, 114};
+    TEST_ASSERT_EQUAL_MEMORY(full, frame, sizeof(frame));
+
+    ShaderEffect effect("Test", test_shader);
+    TEST_ASSERT_TRUE(effect.init(width, height));
+    effect.update(100);
+    effect.setDetailLevel(1);
+    effect.render(frame);
+    const uint8_t half[width * height] = {100, 100, 102, 102, 104, 110, 110, 112, 112, 114};
+    TEST_ASSERT_EQUAL_MEMORY(half, frame, sizeof(frame));
+}
+
+// Zones touching edge to edge are fine; sharing a pixel or hanging off the
+// display is not
+void test_zone_geometry_overlap_and_clipping(void) {
+    ZoneRect clock = {0, 0, 24, 6};
+    ZoneRect ticker = {24, 0, 48, 6};
+    ZoneRect wide = {20, 0, 8, 6};
+    ZoneRect below = {0, 6, 24, 6};
+    TEST_ASSERT_FALSE(ZoneGeometry::overlaps(clock, ticker));
+    TEST_ASSERT_FALSE(ZoneGeometry::overlaps(clock, below));
+    TEST_ASSERT_TRUE(ZoneGeometry::overlaps(clock, wide));
+    TEST_ASSERT_TRUE(ZoneGeometry::overlaps(wide, ticker));
+
+    ZoneRect placed[] = {clock, ticker};
+    TEST_ASSERT_EQUAL_INT(-1, ZoneGeometry::findOverlap(below, placed, 2));
+    TEST_ASSERT_EQUAL_INT(0, ZoneGeometry::findOverlap(wide, placed, 2));
+    ZoneRect inside = {30, 2, 4, 2};
+    TEST_ASSERT_EQUAL_INT(1, ZoneGeometry::findOverlap(inside, placed, 2));
+
+    TEST_ASSERT_TRUE(ZoneGeometry::fits(ticker, 72, 6));
+    ZoneRect off_right = {48, 0, 48, 6};
+    ZoneRect off_left = {-4, 0, 24, 6};
+    TEST_ASSERT_FALSE(ZoneGeometry::fits(off_right, 72, 6));
+    TEST_ASSERT_FALSE(ZoneGeometry::fits(off_left, 72, 6));
+    TEST_ASSERT_FALSE(ZoneGeometry::fits(below, 72, 6));
+    TEST_ASSERT_TRUE(ZoneGeometry::fits(below, 72, 12));
+}
+
 int main() {
     UNITY_BEGIN();
     
-    // RUN_TEST(test_retrotext_pcb_coordinate_conversion);
+    RUN_TEST(test_retrotext_pcb_coordinate_conversion);
+    RUN_TEST(test_layout_reordered_and_mirrored_boards);
+    RUN_TEST(test_layout_rejects_board_past_chain);
+    RUN_TEST(test_layout_rotated_board_and_gaps);
+    RUN_TEST(test_burst_planner_unknown_state_sends_everything);
+    RUN_TEST(test_burst_planner_coalesces_short_gaps);
+    RUN_TEST(test_burst_planner_respects_max_length);
+    RUN_TEST(test_layout_default_grid_rows);
+    RUN_TEST(test_board_chain_full_frame_behind_mux);
+    RUN_TEST(test_board_chain_minimizes_mux_selects);
+    RUN_TEST(test_memory_text_source_reads_windows);
+    RUN_TEST(test_ring_text_source_wraps_and_drops_oldest);
+    RUN_TEST(test_ring_text_source_replaces_in_place);
+    RUN_TEST(test_pixel_kernels_subpixel_blend);
+    RUN_TEST(test_pixel_kernels_layer_blend_modes);
+    RUN_TEST(test_particle_system_steps_and_wraps);
+    RUN_TEST(test_particle_system_lifetime_and_trail);
+    RUN_TEST(test_particle_system_random_is_seeded);
+    RUN_TEST(test_bitboard_shifts_wrap_across_words);
+    RUN_TEST(test_life_effect_blinker);
+    RUN_TEST(test_fixed_math_tables_and_blends);
+    RUN_TEST(test_shader_effect_evaluates_frame);
+    RUN_TEST(test_zone_geometry_overlap_and_clipping);
     
     return UNITY_END();
 }